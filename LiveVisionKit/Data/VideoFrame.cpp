@@ -17,10 +17,127 @@
 
 #include "VideoFrame.hpp"
 
+#include <array>
+#include <memory>
+
 #include "Directives.hpp"
+#include "Functions/OpenCL/Kernels.hpp"
+#include "Functions/OpenCL/KernelPool.hpp"
 
 namespace lvk
 {
+    // Formats: BGR, BGRA, RGB, RGBA, YUV, GRAY
+    constexpr int FORMAT_CHANNELS[] = {3, 4, 3, 4, 3, 1};
+
+    // Matches the YUV coefficients used by cv::cvtColor.
+    constexpr float R2Y = 0.299f, G2Y = 0.587f, B2Y = 0.114f, B2U = 0.492f, R2V = 0.877f;
+    constexpr float U2B = 2.032f, U2G = -0.395f, V2G = -0.581f, V2R = 1.140f;
+
+    // Every conversion is an affine transform of the source channels, with unused
+    // channels being zero. Conversions are composed through an RGBA space, where the
+    // alpha is that of the source, or opaque if the source has no alpha channel.
+    struct FormatConversion
+    {
+        cv::Matx44f transform;
+        cv::Vec4f bias;
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static FormatConversion to_rgba(const VideoFrame::Format format)
+    {
+        switch(format)
+        {
+            case VideoFrame::BGR: return {
+                {0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 255}
+            };
+            case VideoFrame::BGRA: return {
+                {0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 1}, {0, 0, 0, 0}
+            };
+            case VideoFrame::RGB: return {
+                {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 0, 0, 255}
+            };
+            case VideoFrame::RGBA: return {
+                cv::Matx44f::eye(), {0, 0, 0, 0}
+            };
+            case VideoFrame::YUV: return {
+                {1, 0, V2R, 0, 1, U2G, V2G, 0, 1, U2B, 0, 0, 0, 0, 0, 0},
+                {-128.0f * V2R, -128.0f * (U2G + V2G), -128.0f * U2B, 255}
+            };
+            case VideoFrame::GRAY: return {
+                {1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 255}
+            };
+            default: LVK_ASSERT(false && "Unsupported format");
+        }
+        return {};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static FormatConversion from_rgba(const VideoFrame::Format format)
+    {
+        switch(format)
+        {
+            case VideoFrame::BGR: return {
+                {0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0}
+            };
+            case VideoFrame::BGRA: return {
+                {0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 1}, {0, 0, 0, 0}
+            };
+            case VideoFrame::RGB: return {
+                {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 0, 0, 0}
+            };
+            case VideoFrame::RGBA: return {
+                cv::Matx44f::eye(), {0, 0, 0, 0}
+            };
+            case VideoFrame::YUV: return {
+                {
+                    R2Y, G2Y, B2Y, 0,
+                    -B2U * R2Y, -B2U * G2Y, B2U * (1.0f - B2Y), 0,
+                    R2V * (1.0f - R2Y), -R2V * G2Y, -R2V * B2Y, 0,
+                    0, 0, 0, 0
+                },
+                {0, 128, 128, 0}
+            };
+            case VideoFrame::GRAY: return {
+                {R2Y, G2Y, B2Y, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0}
+            };
+            default: LVK_ASSERT(false && "Unsupported format");
+        }
+        return {};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static const FormatConversion& format_conversion(const VideoFrame::Format src, const VideoFrame::Format dst)
+    {
+        // Generate the table of direct conversions between every pair of formats.
+        static const auto conversions = [](){
+            std::array<std::array<FormatConversion, VideoFrame::UNKNOWN>, VideoFrame::UNKNOWN> table;
+            for(int s = 0; s < VideoFrame::UNKNOWN; s++)
+            {
+                for(int d = 0; d < VideoFrame::UNKNOWN; d++)
+                {
+                    const auto to = to_rgba(static_cast<VideoFrame::Format>(s));
+                    const auto from = from_rgba(static_cast<VideoFrame::Format>(d));
+                    table[s][d] = {from.transform * to.transform, from.transform * to.bias + from.bias};
+                }
+            }
+
+            // The Y plane is shared exactly between YUV and GRAY, so avoid the round trip.
+            table[VideoFrame::YUV][VideoFrame::GRAY] = {
+                {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0}
+            };
+            table[VideoFrame::GRAY][VideoFrame::YUV] = {
+                {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 128, 128, 0}
+            };
+            return table;
+        }();
+
+        return conversions[src][dst];
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -172,6 +289,7 @@ namespace lvk
         LVK_ASSERT(new_format != UNKNOWN);
         LVK_ASSERT(format != UNKNOWN);
         LVK_ASSERT(u != dst.u);
+        LVK_ASSERT(channels() == FORMAT_CHANNELS[format]);
 
         // Copy if no format change is required.
         if(new_format == format)
@@ -180,124 +298,58 @@ namespace lvk
             return;
         }
 
-        // Helper Buffers.
-        thread_local cv::UMat step_buffer(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+        const auto& conversion = format_conversion(format, new_format);
+        const int src_channels = FORMAT_CHANNELS[format];
+        const int dst_channels = FORMAT_CHANNELS[new_format];
 
-        // Convert the old format into the new format.
-        switch(format)
+        if(cv::ocl::useOpenCL())
         {
-            case Format::BGR:
-            {
-                // BGR to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::cvtColor(*this, dst, cv::COLOR_BGR2GRAY); break;
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_BGR2RGB); break;
-                    case Format::YUV: cv::cvtColor(*this, dst, cv::COLOR_BGR2YUV); break;
-                    case Format::RGBA: cv::cvtColor(*this, dst, cv::COLOR_BGR2RGBA); break;
-                    case Format::BGRA: cv::cvtColor(*this, dst, cv::COLOR_BGR2BGRA); break;
-                    default: LVK_ASSERT("Unsupported BGR conversion" && false);
-                }
-                break;
-            }
-            case Format::BGRA:
-            {
-                // BGRA to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::cvtColor(*this, dst, cv::COLOR_BGRA2GRAY); break;
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_BGRA2RGB); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_BGRA2BGR); break;
-                    case Format::RGBA: cv::cvtColor(*this, dst, cv::COLOR_BGRA2RGBA); break;
-                    case Format::YUV:
-                    {
-                        cv::cvtColor(*this, step_buffer, cv::COLOR_BGRA2BGR);
-                        cv::cvtColor(step_buffer, dst, cv::COLOR_BGR2YUV);
-                        break;
-                    }
-                    default: LVK_ASSERT("Unsupported BGRA conversion" && false);
-                }
-                break;
-            }
-            case Format::RGB:
-            {
-                // RGB to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::cvtColor(*this, dst, cv::COLOR_RGB2GRAY); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_RGB2BGR); break;
-                    case Format::YUV: cv::cvtColor(*this, dst, cv::COLOR_RGB2YUV); break;
-                    case Format::RGBA: cv::cvtColor(*this, dst, cv::COLOR_RGB2RGBA); break;
-                    case Format::BGRA: cv::cvtColor(*this, dst, cv::COLOR_RGB2BGRA); break;
-                    default: LVK_ASSERT("Unsupported RGB conversion" && false);
-                }
-                break;
-            }
-            case Format::RGBA:
-            {
-                // RGBA to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::cvtColor(*this, dst, cv::COLOR_RGBA2GRAY); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_RGBA2BGR); break;
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_RGBA2RGB); break;
-                    case Format::BGRA: cv::cvtColor(*this, dst, cv::COLOR_RGBA2BGRA); break;
-                    case Format::YUV:
-                    {
-                        cv::cvtColor(*this, step_buffer, cv::COLOR_RGBA2RGB);
-                        cv::cvtColor(step_buffer, dst, cv::COLOR_RGB2YUV);
-                        break;
-                    }
-                    default: LVK_ASSERT("Unsupported RGBA conversion" && false);
-                }
-                break;
-            }
-            case Format::YUV:
+            // Each format pair is converted by one pass of a channel specialized kernel.
+            thread_local std::unique_ptr<ocl::KernelPool> kernel_pools[UNKNOWN][UNKNOWN];
+            auto& kernels = kernel_pools[format][new_format];
+            if(kernels == nullptr)
             {
-                // YUV to ...
-                switch(new_format)
-                {
-                    case Format::GRAY: cv::extractChannel(*this, dst, 0); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_YUV2BGR); break;
-                    case Format::BGRA: cv::cvtColor(*this, step_buffer, cv::COLOR_YUV2BGR, 4); break;
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_YUV2RGB); break;
-                    case Format::RGBA: cv::cvtColor(*this, step_buffer, cv::COLOR_YUV2RGB, 4); break;
-                    default: LVK_ASSERT("Unsupported YUV conversion" && false);
-                }
-                break;
+                const auto program = ocl::load_program(
+                    "convert",
+                    ocl::src::conversion_source,
+                    cv::format("-D SRC_CHANNELS=%d -D DST_CHANNELS=%d", src_channels, dst_channels).c_str()
+                );
+                LVK_ASSERT(!program.empty());
+
+                kernels = std::make_unique<ocl::KernelPool>(program, "convert");
             }
-            case Format::GRAY:
+            auto& kernel = kernels->acquire();
+
+            dst.create(size(), CV_8UC(dst_channels));
+
+            // Find optimal work sizes for the 2D dst buffer.
+            size_t global_work_size[3], local_work_size[3];
+            ocl::optimal_groups(
+                dst, global_work_size, local_work_size, ocl::conversion_kernel_key(src_channels, dst_channels)
+            );
+
+            // Run the kernel in async mode.
+            kernel.args(
+                cv::ocl::KernelArg::ReadOnly(*this),
+                cv::ocl::KernelArg::WriteOnlyNoSize(dst),
+                conversion.transform,
+                conversion.bias
+            );
+
+            kernels->launch(kernel, 2, global_work_size, local_work_size);
+        }
+        else
+        {
+            // NOTE: cv::transform performs the same affine conversion using SIMD,
+            // with the bias in the last column of its (dst x src+1) matrix.
+            cv::Mat matrix(dst_channels, src_channels + 1, CV_32FC1);
+            for(int r = 0; r < dst_channels; r++)
             {
-                // Gray to ...
-                switch(new_format)
-                {
-                    case Format::RGB: cv::cvtColor(*this, dst, cv::COLOR_GRAY2RGB); break;
-                    case Format::BGR: cv::cvtColor(*this, dst, cv::COLOR_GRAY2BGR); break;
-                    case Format::RGBA: cv::cvtColor(*this, dst, cv::COLOR_GRAY2RGBA); break;
-                    case Format::BGRA: cv::cvtColor(*this, dst, cv::COLOR_GRAY2BGRA); break;
-                    case Format::YUV:
-                    {
-                        // Y = gray plane, U = 128 plane, V = 128 plane
-                        thread_local cv::UMat const_plane;
-                        if(const_plane.cols < cols || const_plane.rows < rows || const_plane.empty())
-                        {
-                            // TODO: replace with a sized cache buffer construct
-                            // Cache the const buffer in case the operation happens a lot.
-                            const_plane = zeros(
-                                std::max(rows, const_plane.rows),
-                                std::max(cols, const_plane.cols),
-                                type(), cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY
-                            );
-                            const_plane.setTo(cv::Scalar::all(128));
-                        }
-                        cv::merge(std::vector<cv::UMat>{*this, const_plane, const_plane}, dst);
-                        break;
-                    }
-                    default: LVK_ASSERT("Unsupported GRAY conversion" && false);
-                }
-                break;
+                for(int c = 0; c < src_channels; c++)
+                    matrix.at<float>(r, c) = conversion.transform(r, c);
+                matrix.at<float>(r, src_channels) = conversion.bias[r];
             }
-            default: LVK_ASSERT("Unsupported conversion" && false);
+            cv::transform(*this, dst, matrix);
         }
 
         // Update metadata.
@@ -72,7 +72,7 @@ namespace lvk
                     break;
 
                 m_Settings.filter_chain[i]->apply(
-                    std::move(filter_input), filter_output
+                    std::move(filter_input), filter_output, is_profiling()
                 );
 
                 // If we are saving all outputs, then we cannot move the output
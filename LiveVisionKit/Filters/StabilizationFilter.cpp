@@ -29,6 +29,31 @@ namespace lvk
     constexpr float QA_UPDATE_RATE = 0.1f;
     constexpr float QA_BLEND_STEP = 0.05f;
 
+    constexpr float FRAME_GAP_LIMIT = 4.0f;
+    constexpr float FRAME_INTERVAL_UPDATE_RATE = 0.05f;
+
+    constexpr float GOVERNOR_UPDATE_RATE = 0.1f;
+    constexpr float GOVERNOR_HEADROOM = 0.7f;
+    constexpr size_t GOVERNOR_COOLDOWN_FRAMES = 30;
+
+    struct QualityTier
+    {
+        float feature_scale;
+        float resolution_scale;
+        bool local_motions;
+    };
+
+    // NOTE: tiers are ordered from full quality down to the cheapest tracking. The motion
+    // resolution is never governed, as changing it resets the smoothed camera path.
+    constexpr std::array<QualityTier, 6> QUALITY_TIERS = {{
+        {1.00f, 1.00f, true},
+        {0.75f, 1.00f, true},
+        {0.75f, 0.75f, true},
+        {0.50f, 0.75f, true},
+        {0.50f, 0.50f, true},
+        {0.50f, 0.50f, false}
+    }};
+
 //---------------------------------------------------------------------------------------------------------------------
 
 	StabilizationFilter::StabilizationFilter(const StabilizationFilterSettings& settings)
@@ -43,6 +68,7 @@ namespace lvk
     {
         LVK_ASSERT_01(settings.min_tracking_quality);
         LVK_ASSERT_01(settings.min_scene_quality);
+        LVK_ASSERT(settings.frame_time_budget >= Time());
 
         m_NullMotion.resize(settings.motion_resolution);
 
@@ -53,6 +79,9 @@ namespace lvk
 
         m_Settings = settings;
 
+        if(settings.frame_time_budget.is_zero())
+            m_QualityLevel = 0;
+
         // Link up the motion resolutions.
         static_cast<PathSmootherSettings&>(m_Settings).motion_resolution = settings.motion_resolution;
         static_cast<FrameTrackerSettings&>(m_Settings).motion_resolution = settings.motion_resolution;
@@ -61,7 +90,7 @@ namespace lvk
         m_PathSmoother.configure(m_Settings);
         m_FrameQueue.resize(m_PathSmoother.time_delay() + 1);
 
-        m_FrameTracker.configure(m_Settings);
+        m_FrameTracker.configure(governed_settings(m_QualityLevel));
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -94,14 +123,19 @@ namespace lvk
             return;
         }
 
+        update_quality_governor();
+        m_GovernorTimer.start();
+
         // Track the motion of the incoming frame.
         input.viewAsFormat(m_TrackingFrame, VideoFrame::GRAY);
         auto motion = m_FrameTracker.track(m_TrackingFrame).value_or(m_NullMotion);
 
-        // Apply quality assurance policies
+        // Apply quality assurance policies. NOTE: the timestamp gap must be checked
+        // on every frame, so that the last timestamp and frame interval stay current.
+        const bool timestamp_gap = is_timestamp_gap(input.timestamp);
         const auto tracking_quality = m_FrameTracker.tracking_stability();
         m_SceneQuality = exp_moving_average(m_SceneQuality, tracking_quality, QA_UPDATE_RATE);
-        if(tracking_quality < m_Settings.min_tracking_quality)
+        if(tracking_quality < m_Settings.min_tracking_quality || timestamp_gap)
         {
             // This is most likely a discontinuity
             m_TrustFactor = 0.0f;
@@ -132,6 +166,8 @@ namespace lvk
             correction.apply(next_frame, output, m_Settings.background_colour);
         }
         else output.release();
+
+        m_GovernorTimer.stop();
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -139,10 +175,118 @@ namespace lvk
 	void StabilizationFilter::restart()
 	{
         m_SceneQuality = 1.0f;
+        m_LastTimestamp = 0;
+        m_FrameInterval = 0.0f;
+        m_GovernedFrameTime = 0.0f;
+        m_GovernorCooldown = 0;
+        m_GovernorTimer.reset_history();
         m_FrameQueue.clear();
         reset_context();
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool StabilizationFilter::is_timestamp_gap(const uint64_t timestamp)
+    {
+        // Frames dropped upstream (e.g. by a real-time stream) leave a gap in the
+        // timestamps, which the tracker will see as a sudden jump in motion. Gaps
+        // are measured against a moving average of the typical frame interval.
+        // NOTE: untimed or out of order frames are never treated as gaps.
+        if(timestamp <= m_LastTimestamp)
+            return false;
+
+        const auto previous_timestamp = std::exchange(m_LastTimestamp, timestamp);
+        if(previous_timestamp == 0)
+            return false;
+
+        const auto interval = static_cast<float>(timestamp - previous_timestamp);
+        if(m_FrameInterval == 0.0f)
+        {
+            m_FrameInterval = interval;
+            return false;
+        }
+
+        const bool is_gap = interval > FRAME_GAP_LIMIT * m_FrameInterval;
+        if(!is_gap) m_FrameInterval = exp_moving_average(m_FrameInterval, interval, FRAME_INTERVAL_UPDATE_RATE);
+
+        return is_gap;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StabilizationFilter::update_quality_governor()
+    {
+        // NOTE: the frame timer is only stopped after filtering, so
+        // the newest timing sample always belongs to the last frame.
+        if(m_Settings.frame_time_budget.is_zero() || timings().history().is_empty())
+            return;
+
+        // The host timings miss any OpenCL work that is still queued when the filter
+        // returns, so the governor also considers the newest resolved device timing.
+        auto frame_time = static_cast<float>(timings().history().newest().milliseconds());
+        if(m_GovernorTimer.resolve(); !m_GovernorTimer.history().is_empty())
+            frame_time = std::max(frame_time, static_cast<float>(m_GovernorTimer.history().newest().milliseconds()));
+
+        m_GovernedFrameTime = m_GovernedFrameTime == 0.0f ? frame_time
+            : exp_moving_average(m_GovernedFrameTime, frame_time, GOVERNOR_UPDATE_RATE);
+
+        // Give the frame time a chance to settle after each level change.
+        if(m_GovernorCooldown > 0)
+        {
+            m_GovernorCooldown--;
+            return;
+        }
+
+        // Step down when over budget, but only step back up once there is enough
+        // headroom that the higher quality level is unlikely to exceed it again.
+        const auto budget = static_cast<float>(m_Settings.frame_time_budget.milliseconds());
+        size_t quality_level = m_QualityLevel;
+        if(m_GovernedFrameTime > budget && quality_level + 1 < QUALITY_TIERS.size())
+            quality_level++;
+        else if(m_GovernedFrameTime < GOVERNOR_HEADROOM * budget && quality_level > 0)
+            quality_level--;
+        else
+            return;
+
+        m_FrameTracker.configure(governed_settings(quality_level));
+        m_GovernorCooldown = GOVERNOR_COOLDOWN_FRAMES;
+        m_QualityLevel = quality_level;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    FrameTrackerSettings StabilizationFilter::governed_settings(const size_t quality_level) const
+    {
+        LVK_ASSERT(quality_level < QUALITY_TIERS.size());
+
+        const auto& tier = QUALITY_TIERS[quality_level];
+        FrameTrackerSettings settings = m_Settings;
+
+        // NOTE: the detection resolution is scaled uniformly to keep its aspect ratio,
+        // and never below the detection regions, which must each cover some pixels.
+        settings.detection_resolution.width = std::max(
+            static_cast<int>(std::round(tier.resolution_scale * static_cast<float>(m_Settings.detection_resolution.width))),
+            m_Settings.detection_regions.width
+        );
+        settings.detection_resolution.height = std::max(
+            static_cast<int>(std::round(tier.resolution_scale * static_cast<float>(m_Settings.detection_resolution.height))),
+            m_Settings.detection_regions.height
+        );
+
+        settings.max_feature_density = tier.feature_scale * m_Settings.max_feature_density;
+        settings.min_feature_density = std::min(m_Settings.min_feature_density, settings.max_feature_density);
+        settings.track_local_motions = m_Settings.track_local_motions && tier.local_motions;
+
+        return settings;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t StabilizationFilter::quality_level() const
+    {
+        return m_QualityLevel;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     bool StabilizationFilter::ready() const
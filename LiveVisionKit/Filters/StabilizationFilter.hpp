@@ -36,6 +36,12 @@ namespace lvk
         // Quality Assurance
         float min_scene_quality = 0.8f;
         float min_tracking_quality = 0.3f;
+
+        // Quality Governor
+        // NOTE: the tracking cost is stepped down whenever the filter exceeds
+        // its frame time budget, and back up once there is headroom again.
+        // A zero budget disables the governor.
+        Time frame_time_budget;
 	};
 
 
@@ -59,12 +65,21 @@ namespace lvk
 
         size_t frame_delay() const;
 
+        // NOTE: zero is full quality, safe to read from other threads.
+        size_t quality_level() const;
+
 		cv::Rect stable_region() const;
 
 	private:
 
         void filter(VideoFrame&& input, VideoFrame& output) override;
 
+        bool is_timestamp_gap(const uint64_t timestamp);
+
+        void update_quality_governor();
+
+        FrameTrackerSettings governed_settings(const size_t quality_level) const;
+
 	private:
 		FrameTracker m_FrameTracker;
 		PathSmoother m_PathSmoother;
@@ -75,6 +90,14 @@ namespace lvk
 
         float m_SceneQuality = 0.0f;
         float m_TrustFactor = 0.0f;
+
+        uint64_t m_LastTimestamp = 0;
+        float m_FrameInterval = 0.0f;
+
+        std::atomic<size_t> m_QualityLevel = 0;
+        size_t m_GovernorCooldown = 0;
+        float m_GovernedFrameTime = 0.0f;
+        GPUStopwatch m_GovernorTimer;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,390 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "StreamScheduler.hpp"
+
+#include "Directives.hpp"
+#include "Timing/Trace.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    StreamScheduler::StreamScheduler(TaskPool& pool, const size_t io_threads)
+        : m_IOThreadCount(std::max<size_t>(io_threads, 1)),
+          m_FilterTasks(pool)
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t StreamScheduler::add_stream(
+        const std::function<bool(Frame&)>& source,
+        const std::shared_ptr<VideoFilter>& filter,
+        const std::function<bool(Frame&)>& sink,
+        const ScheduledStreamSettings& settings
+    )
+    {
+        LVK_ASSERT(settings.policy.buffer_frames >= 1);
+        LVK_ASSERT(filter != nullptr);
+
+        std::scoped_lock lock(m_Mutex);
+        LVK_ASSERT(!m_Running);
+
+        auto& stream = m_Streams.emplace_back(std::make_unique<Stream>());
+        stream->source = source;
+        stream->filter = filter;
+        stream->sink = sink;
+        stream->settings = settings;
+
+        return m_Streams.size() - 1;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StreamScheduler::run()
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            LVK_ASSERT(!m_Running);
+
+            m_Running = true;
+            m_StartTime = Time::Now();
+
+            // Kick off every stream by scheduling its first read.
+            m_ActiveStreams = 0;
+            for(size_t i = 0; i < m_Streams.size(); i++)
+            {
+                if(!m_Streams[i]->finished)
+                {
+                    m_ActiveStreams++;
+                    schedule_stages(i);
+                }
+            }
+        }
+
+        std::vector<std::thread> io_workers;
+        io_workers.reserve(m_IOThreadCount - 1);
+        for(size_t i = 1; i < m_IOThreadCount; i++)
+        {
+            io_workers.emplace_back([this](){
+                Trace::set_thread_name("Stream I/O");
+                run_io_worker();
+            });
+        }
+
+        run_io_worker();
+        for(auto& worker : io_workers)
+            worker.join();
+
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Running = false;
+        }
+
+        // NOTE: every stream has ended, so this only passes on any filter exception.
+        m_FilterTasks.wait();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StreamScheduler::run_io_worker()
+    {
+        std::unique_lock lock(m_Mutex);
+        while(true)
+        {
+            m_IOTaskAvailable.wait(lock, [this](){
+                return !m_ReadyIOTasks.empty() || m_ActiveStreams == 0;
+            });
+
+            // If there are no tasks left, then every stream has ended.
+            if(m_ReadyIOTasks.empty())
+                return;
+
+            const Task task = m_ReadyIOTasks.top();
+            m_ReadyIOTasks.pop();
+            run_stage(lock, task);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StreamScheduler::run_next_filter()
+    {
+        std::unique_lock lock(m_Mutex);
+
+        // NOTE: there is one pool task per ready filter stage, but each
+        // runs whichever filter stage is most urgent at the time.
+        LVK_ASSERT(!m_ReadyFilterTasks.empty());
+
+        const Task task = m_ReadyFilterTasks.top();
+        m_ReadyFilterTasks.pop();
+        run_stage(lock, task);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StreamScheduler::run_stage(std::unique_lock<std::mutex>& lock, const Task& task)
+    {
+        // NOTE: must be called while holding the lock, which is released while the stage runs.
+        auto& stream = *m_Streams[task.stream];
+        const auto& policy = stream.settings.policy;
+
+        // Take the stage input while we still hold the lock.
+        Frame frame;
+        if(task.stage == FILTER)
+        {
+            // Skip any frames which have exceeded the latency budget, so
+            // long as there is a newer frame waiting to be filtered instead.
+            if(policy.real_time)
+            {
+                const auto capture_deadline = Time::Now() - m_StartTime - policy.latency_budget;
+                while(stream.filter_queue.size() > 1 && stream.filter_queue.front().timestamp < capture_deadline.nanoseconds())
+                {
+                    stream.filter_queue.pop();
+                    stream.statistics.stale_frames++;
+                }
+            }
+
+            frame = std::move(stream.filter_queue.front());
+            stream.filter_queue.pop();
+        }
+        else if(task.stage == WRITE)
+        {
+            frame = std::move(stream.output_queue.front());
+            stream.output_queue.pop();
+        }
+        lock.unlock();
+
+        // Run the stage, noting whether it read a frame or was asked to terminate.
+        bool frame_read = false, terminate = false;
+        switch(task.stage)
+        {
+            case READ:
+            {
+                TraceScope trace("Read Frame", "scheduler");
+                frame_read = stream.source(frame);
+                if(frame_read)
+                {
+                    LVK_ASSERT(frame.has_known_format());
+                    stream.statistics.frames_read++;
+
+                    // Real-time frames are timestamped at capture, relative to the start of the run.
+                    if(policy.real_time)
+                        frame.timestamp = static_cast<uint64_t>((Time::Now() - m_StartTime).nanoseconds());
+                }
+                break;
+            }
+            case FILTER:
+            {
+                // A failed filter ends its stream, before the exception is passed on to run().
+                Frame filtered_frame;
+                try
+                {
+                    stream.filter->apply(std::move(frame), filtered_frame, false);
+                }
+                catch(...)
+                {
+                    lock.lock();
+                    stream.stage_active[FILTER] = false;
+                    terminate_stream(task.stream);
+                    throw;
+                }
+                frame = std::move(filtered_frame);
+                break;
+            }
+            case WRITE:
+            {
+                stream.statistics.frames_output++;
+                if(policy.real_time)
+                {
+                    const auto capture_time = Time::Nanoseconds(frame.timestamp);
+                    stream.statistics.latency.record(Time::Now() - m_StartTime - capture_time);
+                }
+
+                TraceScope trace("Write Frame", "scheduler");
+                terminate = stream.sink(frame);
+                break;
+            }
+        }
+
+        // The next stage may run on another thread, with its own OpenCL queue, so
+        // the work on the frame must be complete before the frame is handed over.
+        if(task.stage != WRITE && cv::ocl::useOpenCL())
+            cv::ocl::finish();
+
+        lock.lock();
+
+        // Pass the stage output onwards, unless the stream was terminated in the meantime.
+        const size_t buffer_frames = policy.buffer_frames;
+        switch(task.stage)
+        {
+            case READ:
+                if(!frame_read)
+                    stream.input_finished = true;
+                else if(!stream.terminated)
+                {
+                    // Real-time streams never wait on a full buffer, and instead drop the oldest frame.
+                    while(policy.real_time && stream.filter_queue.size() >= buffer_frames)
+                    {
+                        stream.filter_queue.pop();
+                        stream.statistics.dropped_frames++;
+                    }
+                    stream.filter_queue.push(std::move(frame));
+                }
+                break;
+            case FILTER:
+                if(!frame.empty() && !stream.terminated)
+                    stream.output_queue.push(std::move(frame));
+                break;
+            case WRITE:
+                break;
+        }
+
+        stream.stage_active[task.stage] = false;
+        if(terminate)
+            terminate_stream(task.stream);
+        else
+            schedule_stages(task.stream);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StreamScheduler::schedule_stages(const size_t index)
+    {
+        // NOTE: must be called while holding the lock.
+        auto& stream = *m_Streams[index];
+        if(stream.finished)
+            return;
+
+        const auto enqueue = [&](const Stage stage){
+            stream.stage_active[stage] = true;
+
+            const Task task = {stream.settings.priority, stage, m_TaskSequence++, index};
+            if(stage == FILTER)
+            {
+                m_ReadyFilterTasks.push(task);
+                m_FilterTasks.run([this](){
+                    run_next_filter();
+                });
+            }
+            else
+            {
+                m_ReadyIOTasks.push(task);
+                m_IOTaskAvailable.notify_one();
+            }
+        };
+
+        // A stage is ready once it has an input and space for its output. Each stage
+        // is only ever scheduled once at a time, to keep the frames in order.
+        const size_t buffer_frames = stream.settings.policy.buffer_frames;
+        if(!stream.stage_active[WRITE] && !stream.output_queue.empty())
+            enqueue(WRITE);
+
+        if(!stream.stage_active[FILTER] && !stream.filter_queue.empty() && stream.output_queue.size() < buffer_frames)
+            enqueue(FILTER);
+
+        if(!stream.stage_active[READ] && !stream.input_finished
+           && (stream.settings.policy.real_time || stream.filter_queue.size() < buffer_frames))
+            enqueue(READ);
+
+        // The stream has ended once its last frame has drained through every stage.
+        const bool stages_idle = !stream.stage_active[READ] && !stream.stage_active[FILTER] && !stream.stage_active[WRITE];
+        if(stream.input_finished && stages_idle && stream.filter_queue.empty() && stream.output_queue.empty())
+        {
+            stream.finished = true;
+            if(m_Running && --m_ActiveStreams == 0)
+                m_IOTaskAvailable.notify_all();
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StreamScheduler::terminate_stream(const size_t index)
+    {
+        // NOTE: must be called while holding the lock.
+        auto& stream = *m_Streams[index];
+        stream.input_finished = true;
+        stream.terminated = true;
+
+        // Starve out the queues to emulate reaching the end of the stream.
+        while(!stream.filter_queue.empty()) stream.filter_queue.pop();
+        while(!stream.output_queue.empty()) stream.output_queue.pop();
+
+        schedule_stages(index);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StreamScheduler::stop()
+    {
+        std::scoped_lock lock(m_Mutex);
+        for(size_t i = 0; i < m_Streams.size(); i++)
+            terminate_stream(i);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StreamScheduler::stop(const size_t stream)
+    {
+        LVK_ASSERT(stream < m_Streams.size());
+
+        std::scoped_lock lock(m_Mutex);
+        terminate_stream(stream);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t StreamScheduler::stream_count() const
+    {
+        return m_Streams.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t StreamScheduler::io_thread_count() const
+    {
+        return m_IOThreadCount;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const StreamStatistics& StreamScheduler::statistics(const size_t stream) const
+    {
+        LVK_ASSERT(stream < m_Streams.size());
+
+        return m_Streams[stream]->statistics;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool StreamScheduler::Task::operator<(const Task& other) const
+    {
+        // NOTE: the queue runs the greatest task first. So higher priority streams go first,
+        // then later stages, to drain frames out before reading more, then the oldest task.
+        if(priority != other.priority)
+            return priority < other.priority;
+
+        if(stage != other.stage)
+            return stage < other.stage;
+
+        return sequence > other.sequence;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
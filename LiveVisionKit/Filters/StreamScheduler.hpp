@@ -0,0 +1,141 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <queue>
+#include <array>
+#include <mutex>
+
+#include "VideoFilter.hpp"
+#include "Utility/TaskPool.hpp"
+
+namespace lvk
+{
+
+    struct ScheduledStreamSettings
+    {
+        // NOTE: higher priority streams always have their ready stages run first.
+        int priority = 0;
+
+        StreamPolicy policy = {.buffer_frames = 2};
+    };
+
+
+    // Runs many (source, filter, sink) streams on a shared task pool. Each stage of
+    // a stream is run as a task once it is ready, so the stages of one stream are
+    // still pipelined, but never run concurrently with themselves. Unlike streaming
+    // each filter directly, the thread count does not grow with the number of streams.
+    // NOTE: reads and writes may block on their devices, so they are run on a fixed
+    // set of I/O threads, leaving the pool's workers to only run the filter stages.
+    // Each OpenCL queue is per thread, so stages finish their queue before handing
+    // their frame over to the next stage, which may run on another thread.
+    class StreamScheduler
+    {
+    public:
+
+        // NOTE: the I/O threads mostly wait on their devices, so only a few are needed.
+        static constexpr size_t DefaultIOThreads = 2;
+
+
+        explicit StreamScheduler(
+            TaskPool& pool = TaskPool::global(),
+            const size_t io_threads = DefaultIOThreads
+        );
+
+        // NOTE: streams must be added before running, and
+        // their filters must not be shared with other streams.
+        size_t add_stream(
+            const std::function<bool(Frame&)>& source,
+            const std::shared_ptr<VideoFilter>& filter,
+            const std::function<bool(Frame&)>& sink,
+            const ScheduledStreamSettings& settings = {}
+        );
+
+        // NOTE: blocks until every stream has ended, or the scheduler is stopped, while
+        // the calling thread acts as one of the I/O threads. The first exception thrown
+        // by a filter ends its stream, and is rethrown once the other streams have ended.
+        void run();
+
+        // NOTE: safe to call from other threads while running.
+        void stop();
+
+        void stop(const size_t stream);
+
+
+        size_t stream_count() const;
+
+        size_t io_thread_count() const;
+
+        const StreamStatistics& statistics(const size_t stream) const;
+
+    private:
+
+        enum Stage {READ = 0, FILTER = 1, WRITE = 2};
+
+        struct Stream
+        {
+            std::function<bool(Frame&)> source, sink;
+            std::shared_ptr<VideoFilter> filter;
+            ScheduledStreamSettings settings;
+            StreamStatistics statistics;
+
+            std::queue<Frame> filter_queue, output_queue;
+            std::array<bool, 3> stage_active = {false, false, false};
+            bool input_finished = false, terminated = false, finished = false;
+        };
+
+        struct Task
+        {
+            int priority;
+            Stage stage;
+            uint64_t sequence;
+            size_t stream;
+
+            bool operator<(const Task& other) const;
+        };
+
+        void run_io_worker();
+
+        void run_next_filter();
+
+        void run_stage(std::unique_lock<std::mutex>& lock, const Task& task);
+
+        void schedule_stages(const size_t stream);
+
+        void terminate_stream(const size_t stream);
+
+    private:
+        const size_t m_IOThreadCount;
+        TaskGroup m_FilterTasks;
+        std::vector<std::unique_ptr<Stream>> m_Streams;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_IOTaskAvailable;
+        std::priority_queue<Task> m_ReadyIOTasks, m_ReadyFilterTasks;
+        uint64_t m_TaskSequence = 0;
+        size_t m_ActiveStreams = 0;
+        bool m_Running = false;
+        Time m_StartTime;
+    };
+
+}
@@ -18,6 +18,7 @@
 #include "VideoFilter.hpp"
 
 #include <condition_variable>
+#include <optional>
 #include <atomic>
 #include <chrono>
 #include <thread>
@@ -25,6 +26,7 @@
 #include <mutex>
 
 #include "Timing/TickTimer.hpp"
+#include "Timing/Trace.hpp"
 
 namespace lvk
 {
@@ -45,9 +47,20 @@ namespace lvk
 
     void VideoFilter::apply(VideoFrame&& input, VideoFrame& output, const bool profile)
     {
-        m_FrameTimer.sync_gpu(profile).start();
+        TraceScope trace(m_Alias.c_str(), "filter");
+
+        // NOTE: the device timer records markers on the OpenCL queue
+        // instead of synchronizing it, so profiling does not stall.
+        m_Profiling = profile;
+        if(profile) m_DeviceTimer.start();
+        m_FrameTimer.start();
+
+        // Account any memory allocated by the filter to it, for as long as the memory lives.
+        MemoryScope memory_scope(m_MemoryAccount);
         filter(std::move(input), output);
-        m_FrameTimer.sync_gpu(profile).stop();
+
+        m_FrameTimer.stop();
+        if(profile) m_DeviceTimer.stop();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -63,7 +76,54 @@ namespace lvk
     {
         LVK_ASSERT(input.isOpened());
 
-        const size_t max_buffer_frames = 15;
+        stream(
+            [&](Frame& read_frame){
+                if(!input.read(read_frame))
+                    return false;
+
+                // Assume the input frame is BGR
+                read_frame.format = VideoFrame::BGR;
+
+                // Set frame timestamp if supported, otherwise set it to zero.
+                const auto stream_position = std::max(0.0, input.get(cv::CAP_PROP_POS_MSEC));
+                read_frame.timestamp = static_cast<uint64_t>(Time::Milliseconds(stream_position).nanoseconds());
+                return true;
+            },
+            callback,
+            profile
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::stream(
+        const std::function<bool(Frame&)>& source,
+        const std::function<bool(Frame&)>& callback,
+        const bool profile
+    )
+    {
+        stream(source, callback, StreamPolicy{}, profile);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoFilter::stream(
+        const std::function<bool(Frame&)>& source,
+        const std::function<bool(Frame&)>& callback,
+        const StreamPolicy& policy,
+        const bool profile
+    )
+    {
+        LVK_ASSERT(policy.buffer_frames >= 1);
+
+        const size_t max_buffer_frames = policy.buffer_frames;
+        const Time stream_start = Time::Now();
+
+        m_StreamStatistics.frames_read = 0;
+        m_StreamStatistics.frames_output = 0;
+        m_StreamStatistics.dropped_frames = 0;
+        m_StreamStatistics.stale_frames = 0;
+        m_StreamStatistics.latency.reset();
 
         std::mutex input_mutex, output_mutex;
         std::queue<Frame> input_queue, output_queue;
@@ -75,23 +135,46 @@ namespace lvk
         // Input Processor
         // This reads frames from the input stream and passes them off for filtering.
         auto input_thread = std::thread([&](){
+            Trace::set_thread_name("Stream Input");
+
             Frame read_frame;
-            while(input.read(read_frame) && !terminate_input)
+            while(!terminate_input)
             {
-                // Assume the input frame is BGR
-                read_frame.format = VideoFrame::BGR;
+                TraceScope read_trace("Read Frame", "stream");
+                if(!source(read_frame))
+                    break;
+                read_trace.end();
 
-                // Set frame timestamp if supported, otherwise set it to zero.
-                const auto stream_position = std::max(0.0, input.get(cv::CAP_PROP_POS_MSEC));
-                read_frame.timestamp = static_cast<uint64_t>(Time::Milliseconds(stream_position).nanoseconds());
+                LVK_ASSERT(read_frame.has_known_format());
+                m_StreamStatistics.frames_read++;
+
+                // Real-time frames are timestamped at capture, relative to the start of the stream.
+                if(policy.real_time)
+                    read_frame.timestamp = static_cast<uint64_t>((Time::Now() - stream_start).nanoseconds());
 
                 // Push new frame onto the input queue
                 {
                     std::unique_lock<std::mutex> queue_lock(input_mutex);
 
-                    // If the input queue is saturated, wait until a frame is consumed
-                    while(input_queue.size() >= max_buffer_frames)
-                        input_consume_flag.wait(queue_lock);
+                    // If the input queue is saturated, wait until a frame is consumed.
+                    // Real-time streams never wait, and instead drop the oldest frame.
+                    if(input_queue.size() >= max_buffer_frames)
+                    {
+                        if(policy.real_time)
+                        {
+                            while(input_queue.size() >= max_buffer_frames)
+                            {
+                                input_queue.pop();
+                                m_StreamStatistics.dropped_frames++;
+                            }
+                        }
+                        else
+                        {
+                            LVK_TRACE_CATEGORY("Wait (Input Full)", "stream");
+                            while(input_queue.size() >= max_buffer_frames)
+                                input_consume_flag.wait(queue_lock);
+                        }
+                    }
 
                     input_queue.push(std::move(read_frame));
                     if(input_queue.size() == 1)
@@ -106,12 +189,15 @@ namespace lvk
         // Filter Processor
         // This grabs frames delivered by the input processor, filters them, and passes them off for output.
         auto filter_thread = std::thread([&](){
+            Trace::set_thread_name("Stream Filter");
+
             Frame input_frame, filtered_frame;
             while(true)
             {
                 // Pop a frame from the input queue
                 {
                     std::unique_lock<std::mutex> queue_lock(input_mutex);
+                    std::optional<TraceScope> wait_trace;
                     while(input_queue.empty())
                     {
                         // If there are no new frames incoming, then we have filtered everything
@@ -122,8 +208,25 @@ namespace lvk
                             return;
                         }
 
+                        // Only trace the wait if the input is actually starved.
+                        if(!wait_trace.has_value())
+                            wait_trace.emplace("Wait (Input Empty)", "stream");
+
                         input_available_flag.wait(queue_lock);
                     }
+                    wait_trace.reset();
+
+                    // Skip any frames which have exceeded the latency budget, so
+                    // long as there is a newer frame waiting to be filtered instead.
+                    if(policy.real_time)
+                    {
+                        const auto capture_deadline = Time::Now() - stream_start - policy.latency_budget;
+                        while(input_queue.size() > 1 && input_queue.front().timestamp < capture_deadline.nanoseconds())
+                        {
+                            input_queue.pop();
+                            m_StreamStatistics.stale_frames++;
+                        }
+                    }
 
                     input_frame = std::move(input_queue.front());
                     input_queue.pop();
@@ -141,8 +244,12 @@ namespace lvk
                     std::unique_lock<std::mutex> queue_lock(output_mutex);
 
                     // If the output queue is saturated, wait until a frame is consumed
-                    while(output_queue.size() >= max_buffer_frames)
-                        output_consume_flag.wait(queue_lock);
+                    if(output_queue.size() >= max_buffer_frames)
+                    {
+                        LVK_TRACE_CATEGORY("Wait (Output Full)", "stream");
+                        while(output_queue.size() >= max_buffer_frames)
+                            output_consume_flag.wait(queue_lock);
+                    }
 
                     output_queue.push(std::move(filtered_frame));
                     if(output_queue.size() == 1)
@@ -154,12 +261,14 @@ namespace lvk
 
         // Output Processor
         // This grabs filtered frames delivered by the filter processor and sends them to the user callback.
+        // NOTE: this runs on the calling thread, which is not ours to name.
         Frame output_frame;
         while(true)
         {
             // Pop next frame from the output queue
             {
                 std::unique_lock<std::mutex> queue_lock(output_mutex);
+                std::optional<TraceScope> wait_trace;
                 while(output_queue.empty())
                 {
                     // If there are no new frames incoming, then we have finished processing
@@ -170,8 +279,13 @@ namespace lvk
                         return;
                     }
 
+                    // Only trace the wait if the output is actually starved.
+                    if(!wait_trace.has_value())
+                        wait_trace.emplace("Wait (Output Empty)", "stream");
+
                     output_available_flag.wait(queue_lock);
                 }
+                wait_trace.reset();
 
                 output_frame = std::move(output_queue.front());
                 output_queue.pop();
@@ -179,8 +293,19 @@ namespace lvk
                 output_consume_flag.notify_one();
             }
 
+            m_StreamStatistics.frames_output++;
+            if(policy.real_time)
+            {
+                const auto capture_time = Time::Nanoseconds(output_frame.timestamp);
+                m_StreamStatistics.latency.record(Time::Now() - stream_start - capture_time);
+            }
+
             // Send frame to the output
-            if(callback(output_frame))
+            TraceScope callback_trace("Output Callback", "stream");
+            const bool terminate = callback(output_frame);
+            callback_trace.end();
+
+            if(terminate)
             {
                 // User called for the processing to be terminated.
 
@@ -215,6 +340,7 @@ namespace lvk
         LVK_ASSERT(samples >= 1);
 
         m_FrameTimer.set_history_size(samples);
+        m_DeviceTimer.set_history_size(samples);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -224,6 +350,34 @@ namespace lvk
         return m_FrameTimer;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    const GPUStopwatch& VideoFilter::device_timings() const
+    {
+        return m_DeviceTimer;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryUsage VideoFilter::memory_usage() const
+    {
+        return m_MemoryAccount->usage();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const StreamStatistics& VideoFilter::stream_statistics() const
+    {
+        return m_StreamStatistics;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoFilter::is_profiling() const
+    {
+        return m_Profiling;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoFilter::filter(VideoFrame&& input, VideoFrame& output)
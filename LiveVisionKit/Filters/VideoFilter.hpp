@@ -18,16 +18,46 @@
 #pragma once
 
 #include <functional>
+#include <atomic>
 #include <opencv2/opencv.hpp>
 #include <opencv2/videoio.hpp>
 
 #include "Utility/Unique.hpp"
+#include "Utility/MemoryTracker.hpp"
 #include "Data/VideoFrame.hpp"
 #include "Timing/Stopwatch.hpp"
+#include "Timing/GPUStopwatch.hpp"
+#include "Timing/TimeHistogram.hpp"
 
 namespace lvk
 {
 
+    struct StreamPolicy
+    {
+        size_t buffer_frames = 15;
+
+        // NOTE: real-time streams never block the source, keeping only the newest buffered
+        // frames, and skip frames which exceed the latency budget before they are filtered.
+        // Frames are timestamped at capture, so dropped frames show up as timestamp gaps.
+        bool real_time = false;
+        Time latency_budget = Time::Milliseconds(100);
+    };
+
+
+    struct StreamStatistics
+    {
+        std::atomic<uint64_t> frames_read = 0;
+        std::atomic<uint64_t> frames_output = 0;
+
+        // Frames pushed out of the full input buffer, or skipped for exceeding the latency budget.
+        std::atomic<uint64_t> dropped_frames = 0;
+        std::atomic<uint64_t> stale_frames = 0;
+
+        // NOTE: capture to output latency of real-time streams, only updated on the output thread.
+        TimeHistogram latency;
+    };
+
+
     // NOTE: standard colour format is YUV.
 	class VideoFilter : public Unique<VideoFilter>
 	{
@@ -46,17 +76,44 @@ namespace lvk
 
         void stream(cv::VideoCapture& input, const std::function<bool(Frame&)>& callback, const bool profile = false);
 
+        // NOTE: the source must set the format and timestamp of each frame it reads.
+        void stream(
+            const std::function<bool(Frame&)>& source,
+            const std::function<bool(Frame&)>& callback,
+            const bool profile = false
+        );
+
+        void stream(
+            const std::function<bool(Frame&)>& source,
+            const std::function<bool(Frame&)>& callback,
+            const StreamPolicy& policy,
+            const bool profile = false
+        );
+
+        const StreamStatistics& stream_statistics() const;
+
 
         void set_timing_samples(const size_t samples);
 
         const Stopwatch& timings() const;
 
+        const GPUStopwatch& device_timings() const;
+
+        // NOTE: only tracked once the MemoryTracker is installed.
+        MemoryUsage memory_usage() const;
+
     protected:
 
         virtual void filter(VideoFrame&& input, VideoFrame& output);
 
+        bool is_profiling() const;
+
     private:
+        bool m_Profiling = false;
         Stopwatch m_FrameTimer;
+        GPUStopwatch m_DeviceTimer;
+        StreamStatistics m_StreamStatistics;
+        std::shared_ptr<MemoryAccount> m_MemoryAccount = std::make_shared<MemoryAccount>();
 		const std::string m_Alias;
 	};
 
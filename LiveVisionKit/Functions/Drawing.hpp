@@ -110,6 +110,16 @@ namespace lvk
         const cv::Size2f& coord_scaling = {1, 1}
     );
 
+    // NOTE: lines are given as consecutive pairs of start and end points.
+    template<typename T>
+    void draw_lines(
+        cv::UMat& dst,
+        const std::vector<cv::Point_<T>>& lines,
+        const cv::Scalar& color,
+        const int32_t thickness = 2,
+        const cv::Size2f& coord_scaling = {1, 1}
+    );
+
 	template<typename T>
 	void draw_text(
 		cv::UMat& dst,
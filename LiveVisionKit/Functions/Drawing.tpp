@@ -21,6 +21,8 @@
 
 #include "Directives.hpp"
 #include "OpenCL/Kernels.hpp"
+#include "OpenCL/KernelPool.hpp"
+#include "Utility/TaskPool.hpp"
 
 namespace lvk
 {
@@ -61,10 +63,11 @@ namespace lvk
         LVK_ASSERT(thickness >= 1);
         LVK_ASSERT(!dst.empty());
 
-        // Create FSR RCAS kernel
         static auto program = ocl::load_program("draw", ocl::src::drawing_source);
-        thread_local cv::ocl::Kernel kernel("grid", program);
-        LVK_ASSERT(!program.empty() && !kernel.empty());
+        LVK_ASSERT(!program.empty());
+
+        thread_local ocl::KernelPool kernels(program, "grid");
+        auto& kernel = kernels.acquire();
 
         // Find cell size of the grid
         const float cell_width = static_cast<float>(dst.cols) / static_cast<float>(grid.width);
@@ -72,7 +75,7 @@ namespace lvk
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups(dst, global_work_size, local_work_size, "grid");
 
         // Run the kernel in async mode.
         kernel.args(
@@ -84,10 +87,9 @@ namespace lvk
                 static_cast<uint8_t>(color[2]),
                 0 // NOTE: 4th component is unused
             }
-        ).run_(2, global_work_size, local_work_size, false);
+        );
 
-        // Create next kernel while the last one runs.
-        kernel.create("grid", program);
+        kernels.launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -109,10 +111,11 @@ namespace lvk
         if(points.empty())
             return;
 
-        // Create FSR RCAS kernel
         static auto program = ocl::load_program("draw", ocl::src::drawing_source);
-        thread_local cv::ocl::Kernel kernel("points", program);
-        LVK_ASSERT(!program.empty() && !kernel.empty());
+        LVK_ASSERT(!program.empty());
+
+        thread_local ocl::KernelPool kernels(program, "points");
+        auto& kernel = kernels.acquire();
 
         // Upload and scale points to 32bit int image coords.
         thread_local cv::UMat staging_buffer, points_buffer;
@@ -121,7 +124,7 @@ namespace lvk
 
         // Find optimal work sizes for the 1D points buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(points_buffer, global_work_size, local_work_size);
+        ocl::optimal_groups(points_buffer, global_work_size, local_work_size, "points");
 
         // Run the kernel in async mode.
         kernel.args(
@@ -134,10 +137,9 @@ namespace lvk
                 static_cast<uint8_t>(color[2]),
                 0 // NOTE: 4th component is unused
             }
-        ).run_(1, global_work_size, local_work_size, false);
+        );
 
-        // Create next kernel while the last one runs.
-        kernel.create("points", program);
+        kernels.launch(kernel, 1, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -161,10 +163,11 @@ namespace lvk
         if(points.empty())
             return;
 
-        // Create FSR RCAS kernel
         static auto program = ocl::load_program("draw", ocl::src::drawing_source);
-        thread_local cv::ocl::Kernel kernel("crosses", program);
-        LVK_ASSERT(!program.empty() && !kernel.empty());
+        LVK_ASSERT(!program.empty());
+
+        thread_local ocl::KernelPool kernels(program, "crosses");
+        auto& kernel = kernels.acquire();
 
         // Upload and scale points to 32bit int image coords.
         thread_local cv::UMat staging_buffer, points_buffer;
@@ -173,7 +176,7 @@ namespace lvk
 
         // Find optimal work sizes for the 1D points buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(points_buffer, global_work_size, local_work_size);
+        ocl::optimal_groups(points_buffer, global_work_size, local_work_size, "crosses");
 
         // Run the kernel in async mode.
         kernel.args(
@@ -187,10 +190,123 @@ namespace lvk
                 static_cast<uint8_t>(color[2]),
                 0 // NOTE: 4th component is unused
             }
-        ).run_(1, global_work_size, local_work_size, false);
+        );
+
+        kernels.launch(kernel, 1, global_work_size, local_work_size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline void draw_lines(
+        cv::UMat& dst,
+        const std::vector<cv::Point_<T>>& lines,
+        const cv::Scalar& color,
+        const int32_t thickness,
+        const cv::Size2f& coord_scaling
+    )
+    {
+        LVK_ASSERT(coord_scaling.width >= 0 && coord_scaling.height >= 0);
+        LVK_ASSERT(lines.size() % 2 == 0);
+        LVK_ASSERT(dst.type() == CV_8UC3);
+        LVK_ASSERT(thickness >= 1);
+        LVK_ASSERT(!dst.empty());
+
+        if(lines.empty())
+            return;
+
+        // Without OpenCL, draw the lines on the CPU in parallel horizontal tiles.
+        if(!cv::ocl::useOpenCL())
+        {
+            constexpr int32_t tile_height = 64;
+
+            cv::Mat frame = dst.getMat(cv::ACCESS_RW);
+            const int32_t tile_count = (frame.rows + tile_height - 1) / tile_height;
+
+            // Bin each scaled line into the tiles it overlaps, so tiles only draw their own lines.
+            thread_local std::vector<std::vector<cv::Point2f>> tile_line_cache;
+            auto& tile_lines = tile_line_cache;
+            tile_lines.resize(static_cast<size_t>(tile_count));
+            for(auto& tile : tile_lines)
+                tile.clear();
+
+            const float padding = static_cast<float>(thickness) * 0.5f + 1.0f;
+            for(size_t i = 0; i < lines.size(); i += 2)
+            {
+                const cv::Point2f start(
+                    static_cast<float>(lines[i].x) * coord_scaling.width,
+                    static_cast<float>(lines[i].y) * coord_scaling.height
+                );
+                const cv::Point2f end(
+                    static_cast<float>(lines[i + 1].x) * coord_scaling.width,
+                    static_cast<float>(lines[i + 1].y) * coord_scaling.height
+                );
+
+                const auto [min_y, max_y] = std::minmax(start.y, end.y);
+                if(max_y + padding < 0.0f || min_y - padding >= static_cast<float>(frame.rows))
+                    continue;
+
+                const int32_t first_tile = std::max(static_cast<int32_t>((min_y - padding) / tile_height), 0);
+                const int32_t last_tile = std::min(static_cast<int32_t>((max_y + padding) / tile_height), tile_count - 1);
+                for(int32_t t = first_tile; t <= last_tile; t++)
+                {
+                    tile_lines[t].push_back(start);
+                    tile_lines[t].push_back(end);
+                }
+            }
+
+            parallel_for(cv::Range(0, tile_count), [&](const cv::Range& tiles){
+                for(int32_t t = tiles.start; t < tiles.end; t++)
+                {
+                    const int32_t tile_start = t * tile_height;
+                    cv::Mat tile = frame.rowRange(tile_start, std::min(tile_start + tile_height, frame.rows));
+
+                    // Lines are clipped by the tile, so each tile only writes to its own rows.
+                    const cv::Point2f tile_offset(0.0f, static_cast<float>(tile_start));
+                    const auto& points = tile_lines[t];
+                    for(size_t i = 0; i < points.size(); i += 2)
+                        cv::line(tile, points[i] - tile_offset, points[i + 1] - tile_offset, color, thickness);
+                }
+            });
+            return;
+        }
+
+        static auto program = ocl::load_program("draw", ocl::src::drawing_source);
+        LVK_ASSERT(!program.empty());
+
+        thread_local ocl::KernelPool kernels(program, "lines");
+        auto& kernel = kernels.acquire();
+
+        // Upload and scale the line end points to 32bit int image coords.
+        // Each line is packed into a single four channel element.
+        thread_local cv::UMat staging_buffer, lines_buffer;
+        cv::Mat(lines, false).reshape(4).copyTo(staging_buffer);
+        cv::multiply(
+            staging_buffer,
+            cv::Scalar(coord_scaling.width, coord_scaling.height, coord_scaling.width, coord_scaling.height),
+            lines_buffer,
+            1,
+            CV_32S
+        );
+
+        // Find optimal work sizes for the 1D lines buffer.
+        size_t global_work_size[3], local_work_size[3];
+        ocl::optimal_groups(lines_buffer, global_work_size, local_work_size, "lines");
+
+        // Run the kernel in async mode.
+        kernel.args(
+            cv::ocl::KernelArg::ReadOnly(lines_buffer),
+            cv::ocl::KernelArg::WriteOnly(dst),
+            thickness,
+            cv::Vec4b{
+                static_cast<uint8_t>(color[0]),
+                static_cast<uint8_t>(color[1]),
+                static_cast<uint8_t>(color[2]),
+                0 // NOTE: 4th component is unused
+            }
+        );
 
-        // Create next kernel while the last one runs.
-        kernel.create("crosses", program);
+        kernels.launch(kernel, 1, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
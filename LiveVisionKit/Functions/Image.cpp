@@ -18,6 +18,7 @@
 #include "Image.hpp"
 
 #include "OpenCL/Kernels.hpp"
+#include "OpenCL/KernelPool.hpp"
 #include "Directives.hpp"
 
 namespace lvk
@@ -40,13 +41,11 @@ namespace lvk
         static auto program_bgr = ocl::load_program("fsr", ocl::src::fsr_source);
         LVK_ASSERT(!program_yuv.empty() && !program_bgr.empty());
 
-        // Create FSR EASU kernel
-        thread_local cv::ocl::Kernel kernel;
-        thread_local bool kernel_is_yuv = yuv;
-        if(kernel.empty() || kernel_is_yuv != yuv)
-        {
-            kernel.create("easu_remap", yuv ? program_yuv : program_bgr);
-        }
+        // Acquire FSR EASU kernel
+        thread_local ocl::KernelPool yuv_kernels(program_yuv, "easu_remap");
+        thread_local ocl::KernelPool bgr_kernels(program_bgr, "easu_remap");
+        auto& kernels = yuv ? yuv_kernels : bgr_kernels;
+        auto& kernel = kernels.acquire();
 
         // Allocate the output based on the size of the offset map. This allows
         // an ROI of the source to be remapped and scaling operations to occur.
@@ -59,7 +58,7 @@ namespace lvk
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups(dst, global_work_size, local_work_size, "easu_remap");
 
         // Run the kernel in async mode.
         kernel.args(
@@ -73,11 +72,9 @@ namespace lvk
                 static_cast<uint8_t>(background[2]),
                 0 // NOTE: 4th component is unused
             )
-        ).run_(2, global_work_size, local_work_size, false);
+        );
 
-        // Create next kernel while the last one runs.
-        kernel.create("easu_remap", yuv ? program_yuv : program_bgr);
-        kernel_is_yuv = yuv;
+        kernels.launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -104,13 +101,11 @@ namespace lvk
         static auto program_bgr = ocl::load_program("fsr", ocl::src::fsr_source);
         LVK_ASSERT(!program_yuv.empty() && !program_bgr.empty());
 
-        // Create FSR EASU kernel
-        thread_local cv::ocl::Kernel kernel;
-        thread_local bool kernel_is_yuv = yuv;
-        if(kernel.empty() || kernel_is_yuv != yuv)
-        {
-            kernel.create("easu_remap_homography", yuv ? program_yuv : program_bgr);
-        }
+        // Acquire FSR EASU kernel
+        thread_local ocl::KernelPool yuv_kernels(program_yuv, "easu_remap_homography");
+        thread_local ocl::KernelPool bgr_kernels(program_bgr, "easu_remap_homography");
+        auto& kernels = yuv ? yuv_kernels : bgr_kernels;
+        auto& kernel = kernels.acquire();
 
         // Allocate the output based on the input size.
         dst.create(src.size(), CV_8UC3);
@@ -122,7 +117,7 @@ namespace lvk
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups(dst, global_work_size, local_work_size, "easu_remap_homography");
 
         // Invert homography if it isn't already.
         cv::Mat t;
@@ -143,11 +138,9 @@ namespace lvk
                         static_cast<uint8_t>(background[2]),
                         0 // NOTE: 4th component is unused
                 )
-        ).run_(2, global_work_size, local_work_size, false);
+        );
 
-        // Create next kernel while the last one runs.
-        kernel.create("easu_remap_homography", yuv ? program_yuv : program_bgr);
-        kernel_is_yuv = yuv;
+        kernels.launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -170,20 +163,18 @@ namespace lvk
         static auto program_bgr = ocl::load_program("fsr", ocl::src::fsr_source);
         LVK_ASSERT(!program_yuv.empty() && !program_bgr.empty());
 
-        // Create FSR EASU kernel
-        thread_local cv::ocl::Kernel kernel;
-        thread_local bool kernel_is_yuv = yuv;
-        if(kernel.empty() || kernel_is_yuv != yuv)
-        {
-            kernel.create("easu_scale", yuv ? program_yuv : program_bgr);
-        }
+        // Acquire FSR EASU kernel
+        thread_local ocl::KernelPool yuv_kernels(program_yuv, "easu_scale");
+        thread_local ocl::KernelPool bgr_kernels(program_bgr, "easu_scale");
+        auto& kernels = yuv ? yuv_kernels : bgr_kernels;
+        auto& kernel = kernels.acquire();
 
         // Allocate the output.
         dst.create(size, CV_8UC3);
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups(dst, global_work_size, local_work_size, "easu_scale");
 
         // Run the kernel in async mode.
         kernel.args(
@@ -193,11 +184,9 @@ namespace lvk
                 static_cast<float>(src.cols) / static_cast<float>(dst.cols),
                 static_cast<float>(src.rows) / static_cast<float>(dst.rows)
             }
-        ).run_(2, global_work_size, local_work_size, false);
+        );
 
-        // Create next kernel while the last one runs.
-        kernel.create("easu_scale", yuv ? program_yuv : program_bgr);
-        kernel_is_yuv = yuv;
+        kernels.launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -209,27 +198,28 @@ namespace lvk
         LVK_ASSERT_01(sharpness);
         LVK_ASSERT(!src.empty());
 
-        // Create FSR RCAS kernel
+        // Acquire FSR RCAS kernel
         static auto program = ocl::load_program("fsr", ocl::src::fsr_source);
-        thread_local cv::ocl::Kernel kernel("rcas", program);
-        LVK_ASSERT(!program.empty() && !kernel.empty());
+        LVK_ASSERT(!program.empty());
+
+        thread_local ocl::KernelPool kernels(program, "rcas");
+        auto& kernel = kernels.acquire();
 
         // Allocate the output.
         dst.create(src.size(), CV_8UC3);
 
         // Find optimal work sizes for the 2D dst buffer.
         size_t global_work_size[3], local_work_size[3];
-        ocl::optimal_groups(dst, global_work_size, local_work_size);
+        ocl::optimal_groups(dst, global_work_size, local_work_size, "rcas");
 
         // Run the kernel in async mode.
         kernel.args(
             cv::ocl::KernelArg::ReadOnly(src),
             cv::ocl::KernelArg::WriteOnlyNoSize(dst),
             std::exp2(-2.0f * (1.0f - sharpness))
-        ).run_(2, global_work_size, local_work_size, false);
+        );
 
-        // Create next kernel while the last one runs.
-        kernel.create("rcas", program);
+        kernels.launch(kernel, 2, global_work_size, local_work_size);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
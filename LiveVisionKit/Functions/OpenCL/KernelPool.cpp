@@ -0,0 +1,206 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#include "KernelPool.hpp"
+
+#define CL_TARGET_OPENCL_VERSION 120
+#include <CL/cl.h>
+
+#include "Directives.hpp"
+
+namespace lvk::ocl
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    KernelPool::KernelPool(const cv::ocl::Program& program, const char* name, const size_t capacity)
+        : m_Program(program),
+          m_Name(name),
+          m_Capacity(capacity)
+    {
+        LVK_ASSERT(!program.empty());
+        LVK_ASSERT(capacity > 0);
+
+        // NOTE: slots are never reallocated so that acquired kernels remain valid.
+        m_Slots.reserve(capacity);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    KernelPool::~KernelPool()
+    {
+        for(auto& slot : m_Slots)
+            if(slot.completion != nullptr)
+                clReleaseEvent(static_cast<cl_event>(slot.completion));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::ocl::Kernel& KernelPool::acquire()
+    {
+        // Prefer the oldest free kernel, as it is the most likely to have completed.
+        for(size_t i = 0; i < m_Slots.size(); i++)
+        {
+            auto& slot = m_Slots[(m_Next + i) % m_Slots.size()];
+            if(!slot.acquired && is_free(slot))
+            {
+                m_Next = (m_Next + i + 1) % m_Slots.size();
+                slot.acquired = true;
+                return slot.kernel;
+            }
+        }
+
+        // Grow the pool if all existing kernels are still in flight.
+        if(m_Slots.size() < m_Capacity)
+        {
+            auto& slot = m_Slots.emplace_back();
+            slot.kernel.create(m_Name, m_Program);
+            LVK_ASSERT(!slot.kernel.empty());
+
+            slot.acquired = true;
+            return slot.kernel;
+        }
+
+        // Otherwise we have no choice but to wait for the oldest launch.
+        auto& slot = m_Slots[m_Next];
+        LVK_ASSERT(!slot.acquired && "All pooled kernels are acquired but not launched");
+
+        wait(slot);
+        m_Next = (m_Next + 1) % m_Slots.size();
+        slot.acquired = true;
+        return slot.kernel;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void KernelPool::launch(cv::ocl::Kernel& kernel, const int dims, size_t global_size[], size_t local_size[])
+    {
+        LVK_ASSERT(dims >= 1 && dims <= 3);
+
+        for(auto& slot : m_Slots)
+        {
+            if(&slot.kernel != &kernel)
+                continue;
+
+            LVK_ASSERT(slot.acquired);
+            slot.acquired = false;
+
+            const bool launched = kernel.run_(dims, global_size, local_size, false);
+            LVK_ASSERT(launched && "Failed to launch pooled kernel");
+
+            // Track the completion of the launch with a marker, which the in-order queue
+            // only completes once the launch has. Without one, the slot is free right away,
+            // as the launched kernel is replaced below and so is never run again.
+            auto queue = static_cast<cl_command_queue>(cv::ocl::Queue::getDefault().ptr());
+            if(queue != nullptr)
+            {
+                cl_event completion = nullptr;
+                if(clEnqueueMarkerWithWaitList(queue, 0, nullptr, &completion) == CL_SUCCESS)
+                {
+                    slot.completion = completion;
+                    clFlush(queue);
+                }
+            }
+
+            // OpenCV keeps the launched kernel, along with its arguments, alive until its
+            // completion callback. So hand that kernel over to OpenCV and take a fresh one.
+            slot.kernel.create(m_Name, m_Program);
+            LVK_ASSERT(!slot.kernel.empty());
+            return;
+        }
+
+        LVK_ASSERT(false && "Kernel does not belong to the pool");
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t KernelPool::size() const
+    {
+        return m_Slots.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t KernelPool::capacity() const
+    {
+        return m_Capacity;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t KernelPool::in_flight() const
+    {
+        size_t count = 0;
+        for(const auto& slot : m_Slots)
+        {
+            if(slot.completion == nullptr)
+                continue;
+
+            cl_int status = CL_QUEUED;
+            clGetEventInfo(
+                static_cast<cl_event>(slot.completion),
+                CL_EVENT_COMMAND_EXECUTION_STATUS,
+                sizeof(status),
+                &status,
+                nullptr
+            );
+            count += status > CL_COMPLETE;
+        }
+        return count;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool KernelPool::is_free(Slot& slot) const
+    {
+        if(slot.completion == nullptr)
+            return true;
+
+        cl_int status = CL_QUEUED;
+        clGetEventInfo(
+            static_cast<cl_event>(slot.completion),
+            CL_EVENT_COMMAND_EXECUTION_STATUS,
+            sizeof(status),
+            &status,
+            nullptr
+        );
+
+        // NOTE: negative statuses are errors, which also end the launch.
+        if(status > CL_COMPLETE)
+            return false;
+
+        clReleaseEvent(static_cast<cl_event>(slot.completion));
+        slot.completion = nullptr;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void KernelPool::wait(Slot& slot) const
+    {
+        if(slot.completion == nullptr)
+            return;
+
+        auto event = static_cast<cl_event>(slot.completion);
+        clWaitForEvents(1, &event);
+        clReleaseEvent(event);
+        slot.completion = nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
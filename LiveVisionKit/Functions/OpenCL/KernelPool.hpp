@@ -0,0 +1,83 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#pragma once
+
+#include <vector>
+#include <opencv2/core/ocl.hpp>
+
+namespace lvk::ocl
+{
+
+    // NOTE: OpenCV kernels cannot be given new arguments while they are in flight,
+    // so the pool keeps a ring of kernels which are only reused once the launch
+    // of the kernel has completed on the default queue. Pools are not thread safe.
+    class KernelPool
+    {
+    public:
+
+        static constexpr size_t DefaultCapacity = 4;
+
+
+        KernelPool(const cv::ocl::Program& program, const char* name, const size_t capacity = DefaultCapacity);
+
+        KernelPool(const KernelPool&) = delete;
+
+        ~KernelPool();
+
+
+        // Returns a kernel which is free to be argumented and run.
+        cv::ocl::Kernel& acquire();
+
+        // Launches an acquired kernel, returning it to the pool to be reused once the launch completes.
+        // NOTE: the kernel is run asynchronously through OpenCV, which syncs any temporary UMats and
+        // releases the arguments in a completion callback. That callback may fire after the launch has
+        // completed, so the launched kernel is swapped out for a fresh one, rather than re-argumented.
+        void launch(cv::ocl::Kernel& kernel, const int dims, size_t global_size[], size_t local_size[]);
+
+
+        size_t size() const;
+
+        size_t capacity() const;
+
+        size_t in_flight() const;
+
+
+        KernelPool& operator=(const KernelPool&) = delete;
+
+    private:
+
+        struct Slot
+        {
+            cv::ocl::Kernel kernel;
+            void* completion = nullptr;
+            bool acquired = false;
+        };
+
+        bool is_free(Slot& slot) const;
+
+        void wait(Slot& slot) const;
+
+    private:
+        cv::ocl::Program m_Program;
+        const char* m_Name;
+
+        std::vector<Slot> m_Slots;
+        size_t m_Capacity, m_Next = 0;
+    };
+
+}
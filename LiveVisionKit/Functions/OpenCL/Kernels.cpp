@@ -17,57 +17,514 @@
 
 #include "Kernels.hpp"
 
+#include <map>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <tuple>
+#include <fstream>
+#include <optional>
+#include <cstdlib>
+
 #include "Directives.hpp"
 
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace lvk::ocl
 {
 
 //---------------------------------------------------------------------------------------------------------------------
 
-cv::ocl::Program load_program(const char* name, const char* source, const char* flags)
-{
-    cv::String compilation_log;
-
-    cv::ocl::ProgramSource program_source(name, name, source, "");
-    cv::ocl::Program program(program_source, flags, compilation_log);
-    if(program.ptr() == nullptr)
-    {
-        // Perform custom assert with compilation error log.
-        lvk::context::assert_handler(
-            LVK_FILE,
-            __func__,
-            std::string("Failed to compile OpenCL program \'")
-                + name + "\' with compilation log: \n\n" + compilation_log
-        );
-        return {};
+    // Programs which are compiled by warmup_programs().
+    struct ProgramDefinition {const char* name; const char* source; const char* flags;};
+    static const ProgramDefinition LVK_PROGRAMS[] = {
+        {"fsr", src::fsr_source, ""},
+        {"fsr", src::fsr_source, "-D YUV_INPUT"},
+        {"draw", src::drawing_source, ""},
+        {"convert", src::conversion_source, "-D SRC_CHANNELS=1 -D DST_CHANNELS=3"},
+        {"convert", src::conversion_source, "-D SRC_CHANNELS=1 -D DST_CHANNELS=4"},
+        {"convert", src::conversion_source, "-D SRC_CHANNELS=3 -D DST_CHANNELS=1"},
+        {"convert", src::conversion_source, "-D SRC_CHANNELS=3 -D DST_CHANNELS=3"},
+        {"convert", src::conversion_source, "-D SRC_CHANNELS=3 -D DST_CHANNELS=4"},
+        {"convert", src::conversion_source, "-D SRC_CHANNELS=4 -D DST_CHANNELS=1"},
+        {"convert", src::conversion_source, "-D SRC_CHANNELS=4 -D DST_CHANNELS=3"},
+        {"convert", src::conversion_source, "-D SRC_CHANNELS=4 -D DST_CHANNELS=4"}
+    };
+
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    struct LoadedProgram
+    {
+        cv::ocl::Program program;
+
+        // NOTE: OpenCV does not copy program binaries, so they must outlive the program.
+        std::vector<unsigned char> binary;
     };
-    return std::move(program);
-}
+
+    // Work group sizes are tuned per kernel and buffer size, with the last tuned
+    // sizes of a kernel being used when its exact buffer size was never tuned.
+    struct TunedWorkGroup {cv::Size buffer_size, local_size;};
+
+    static std::mutex tuning_mutex;
+    static std::optional<std::map<std::string, std::vector<TunedWorkGroup>>> tuned_work_groups;
+
+    // NOTE: bumped whenever the tuning table changes, to invalidate the lookups cached by each thread.
+    static std::atomic<uint64_t> tuning_generation = 1;
+
+    static std::mutex program_mutex;
+    static std::map<std::tuple<void*, std::string, std::string, uint64_t>, LoadedProgram> loaded_programs;
+    static std::optional<std::filesystem::path> program_cache_directory;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static uint64_t fnv_hash(const std::string& data, uint64_t seed = FNV_OFFSET_BASIS)
+    {
+        // FNV-1a hash, which is stable across platforms and runs.
+        for(const char c : data)
+        {
+            seed ^= static_cast<uint8_t>(c);
+            seed *= FNV_PRIME;
+        }
+        return seed;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static const std::filesystem::path& current_program_cache()
+    {
+        // NOTE: the cache is kept per user, as any user could plant binaries in a shared
+        // directory. Without a per user cache location, the binary cache is disabled.
+        if(!program_cache_directory.has_value())
+        {
+            std::filesystem::path cache_root;
+#ifdef _WIN32
+            if(const char* local_app_data = std::getenv("LOCALAPPDATA"); local_app_data != nullptr)
+                cache_root = local_app_data;
+#else
+            // As per the XDG specification, relative cache paths are invalid and must be ignored.
+            if(const char* xdg_cache = std::getenv("XDG_CACHE_HOME"); xdg_cache != nullptr && xdg_cache[0] == '/')
+                cache_root = xdg_cache;
+            else if(const char* home = std::getenv("HOME"); home != nullptr && home[0] == '/')
+                cache_root = std::filesystem::path(home) / ".cache";
+#endif
+            program_cache_directory = cache_root.empty() ? std::filesystem::path() : cache_root / "LiveVisionKit" / "kernels";
+        }
+        return *program_cache_directory;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Cache entries are only trusted if they belong to the current user, and no one else can modify them.
+    static bool is_trusted(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        // NOTE: the local app data of each user is private to them by default.
+        std::error_code error;
+        return std::filesystem::exists(path, error);
+#else
+        struct stat info = {};
+        return ::stat(path.c_str(), &info) == 0
+            && info.st_uid == ::geteuid()
+            && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Creates the cache directory, restricted to the current user, returning whether it can be trusted.
+    static bool prepare_cache_directory(const std::filesystem::path& directory)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if(error) return false;
+
+        std::filesystem::permissions(
+            directory,
+            std::filesystem::perms::owner_all,
+            std::filesystem::perm_options::replace,
+            error
+        );
+        return !error && is_trusted(directory);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Restricts a written cache entry to the current user, so that it will be trusted when read back.
+    static bool restrict_cache_entry(const std::filesystem::path& path)
+    {
+        std::error_code error;
+        std::filesystem::permissions(
+            path,
+            std::filesystem::perms::owner_read | std::filesystem::perms::owner_write,
+            std::filesystem::perm_options::replace,
+            error
+        );
+        return !error;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::optional<uint64_t> device_hash(const uint64_t seed = FNV_OFFSET_BASIS)
+    {
+        if(!cv::ocl::haveOpenCL())
+            return std::nullopt;
+
+        const auto& device = cv::ocl::Device::getDefault();
+        if(device.empty())
+            return std::nullopt;
+
+        uint64_t key = fnv_hash(device.name(), seed);
+        key = fnv_hash(device.vendorName(), key);
+        key = fnv_hash(device.version(), key);
+        return fnv_hash(device.driverVersion(), key);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::filesystem::path cached_binary_path(const char* name, const uint64_t source_hash, const std::string& flags)
+    {
+        // Binaries are only valid for the exact device and driver that compiled them.
+        const auto& directory = current_program_cache();
+        const auto key = device_hash(source_hash);
+        if(directory.empty() || !key.has_value())
+            return {};
+
+        return directory / cv::format(
+            "%s-%016llx.bin", name, static_cast<unsigned long long>(fnv_hash(flags, *key))
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static bool read_binary(const std::filesystem::path& path, std::vector<unsigned char>& binary)
+    {
+        if(!is_trusted(path.parent_path()) || !is_trusted(path))
+            return false;
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if(!file.good())
+            return false;
+
+        binary.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(binary.data()), static_cast<std::streamsize>(binary.size()));
+
+        return file.good() && !binary.empty();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void write_binary(const std::filesystem::path& path, const std::vector<char>& binary)
+    {
+        if(!prepare_cache_directory(path.parent_path()))
+            return;
+
+        // NOTE: the binary is written to a unique temporary file then renamed into place,
+        // so that other processes never see a partially written binary in the cache.
+        const auto temp_path = std::filesystem::path(path).concat(
+            cv::format(".%llx.tmp", static_cast<unsigned long long>(cv::getTickCount()))
+        );
+
+        std::ofstream file(temp_path, std::ios::binary);
+        file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+        file.close();
+
+        std::error_code error;
+        if(file.good() && restrict_cache_entry(temp_path))
+            std::filesystem::rename(temp_path, path, error);
+
+        if(!file.good() || error)
+            std::filesystem::remove(temp_path, error);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::ocl::Program load_program(const char* name, const char* source, const char* flags)
+    {
+        std::scoped_lock lock(program_mutex);
+
+        const uint64_t source_hash = fnv_hash(source);
+
+        // Programs are shared by all callers within the same OpenCL context.
+        auto& loaded = loaded_programs[{cv::ocl::Context::getDefault().ptr(), name, flags, source_hash}];
+        if(!loaded.program.empty())
+            return loaded.program;
+
+        cv::String compilation_log;
+
+        const auto binary_path = cached_binary_path(name, source_hash, flags);
+        if(!binary_path.empty() && read_binary(binary_path, loaded.binary))
+        {
+            const auto program_binary = cv::ocl::ProgramSource::fromBinary(
+                name, name, loaded.binary.data(), loaded.binary.size(), flags
+            );
+            loaded.program = cv::ocl::Program(program_binary, flags, compilation_log);
+
+            if(loaded.program.ptr() != nullptr)
+                return loaded.program;
+
+            // The cached binary is stale or corrupt, so fall back to compiling the source.
+            loaded.program = {};
+            loaded.binary.clear();
+            compilation_log.clear();
+        }
+
+        cv::ocl::ProgramSource program_source(name, name, source, "");
+        loaded.program = cv::ocl::Program(program_source, flags, compilation_log);
+        if(loaded.program.ptr() == nullptr)
+        {
+            // Perform custom assert with compilation error log.
+            lvk::context::assert_handler(
+                LVK_FILE,
+                __func__,
+                std::string("Failed to compile OpenCL program \'")
+                    + name + "\' with compilation log: \n\n" + compilation_log
+            );
+            return {};
+        }
+
+        if(!binary_path.empty())
+        {
+            std::vector<char> binary;
+            loaded.program.getBinary(binary);
+            if(!binary.empty())
+                write_binary(binary_path, binary);
+        }
+
+        return loaded.program;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void warmup_programs()
+    {
+        if(!cv::ocl::haveOpenCL())
+            return;
+
+        for(const auto& [name, source, flags] : LVK_PROGRAMS)
+            load_program(name, source, flags);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const char* conversion_kernel_key(const int src_channels, const int dst_channels)
+    {
+        LVK_ASSERT(src_channels == 1 || src_channels == 3 || src_channels == 4);
+        LVK_ASSERT(dst_channels == 1 || dst_channels == 3 || dst_channels == 4);
+
+        // NOTE: tuning lookups are cached by the address of the key, so keys must be literals.
+        static const char* const keys[3][3] = {
+            {"convert_1_1", "convert_1_3", "convert_1_4"},
+            {"convert_3_1", "convert_3_3", "convert_3_4"},
+            {"convert_4_1", "convert_4_3", "convert_4_4"}
+        };
+
+        const auto index = [](const int channels){
+            return channels == 1 ? 0 : channels - 2;
+        };
+        return keys[index(src_channels)][index(dst_channels)];
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void set_program_cache(const std::filesystem::path& directory)
+    {
+        std::scoped_lock lock(program_mutex);
+        program_cache_directory = directory;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::filesystem::path program_cache()
+    {
+        std::scoped_lock lock(program_mutex);
+        return current_program_cache();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::filesystem::path tuning_table_path()
+    {
+        const auto directory = program_cache();
+        const auto key = device_hash();
+        if(directory.empty() || !key.has_value())
+            return {};
+
+        return directory / cv::format("work_groups-%016llx.txt", static_cast<unsigned long long>(*key));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::map<std::string, std::vector<TunedWorkGroup>>& tuning_table()
+    {
+        if(tuned_work_groups.has_value())
+            return *tuned_work_groups;
+
+        // Each line of the table is: kernel buffer_width buffer_height local_width local_height
+        auto& table = tuned_work_groups.emplace();
+        if(const auto path = tuning_table_path(); !path.empty() && is_trusted(path.parent_path()) && is_trusted(path))
+        {
+            std::ifstream file(path);
+
+            std::string kernel;
+            TunedWorkGroup entry;
+            while(file >> kernel
+                       >> entry.buffer_size.width >> entry.buffer_size.height
+                       >> entry.local_size.width >> entry.local_size.height)
+            {
+                if(entry.local_size.width > 0 && entry.local_size.height > 0)
+                    table[kernel].push_back(entry);
+            }
+        }
+        return table;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::optional<cv::Size> find_work_group(const char* kernel, const cv::Size& buffer_size)
+    {
+        std::scoped_lock lock(tuning_mutex);
+
+        const auto& table = tuning_table();
+        const auto entries = table.find(kernel);
+        if(entries == table.end() || entries->second.empty())
+            return std::nullopt;
+
+        // Prefer an exact match, otherwise use the entry of the most similar area.
+        const double area = std::max(buffer_size.area(), 1);
+        const TunedWorkGroup* closest = nullptr;
+        double closest_distance = std::numeric_limits<double>::max();
+        for(const auto& entry : entries->second)
+        {
+            if(entry.buffer_size == buffer_size)
+                return entry.local_size;
+
+            const double distance = std::abs(std::log(std::max(entry.buffer_size.area(), 1) / area));
+            if(distance < closest_distance)
+            {
+                closest_distance = distance;
+                closest = &entry;
+            }
+        }
+        return closest->local_size;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<cv::Size> tuned_work_group(const char* kernel, const cv::Size& buffer_size)
+    {
+        // NOTE: this is called on every kernel launch, but the table only changes while tuning.
+        // So each thread caches its lookups, only taking the lock again once the table changes.
+        thread_local uint64_t cached_generation = 0;
+        thread_local std::map<std::tuple<const char*, int, int>, std::optional<cv::Size>> cached_groups;
+
+        if(const uint64_t generation = tuning_generation.load(); generation != cached_generation)
+        {
+            cached_groups.clear();
+            cached_generation = generation;
+        }
+
+        const auto key = std::make_tuple(kernel, buffer_size.width, buffer_size.height);
+        if(const auto cached = cached_groups.find(key); cached != cached_groups.end())
+            return cached->second;
+
+        return cached_groups[key] = find_work_group(kernel, buffer_size);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void set_work_group(const char* kernel, const cv::Size& buffer_size, const cv::Size& local_size)
+    {
+        LVK_ASSERT(local_size.width > 0 && local_size.height > 0);
+
+        std::scoped_lock lock(tuning_mutex);
+
+        auto& entries = tuning_table()[kernel];
+        for(auto& entry : entries)
+        {
+            if(entry.buffer_size == buffer_size)
+            {
+                entry.local_size = local_size;
+                tuning_generation++;
+                return;
+            }
+        }
+        entries.push_back({buffer_size, local_size});
+        tuning_generation++;
+    }
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    void optimal_groups(const cv::UMat& buffer, size_t global_groups[3], size_t local_groups[3])
+    bool save_work_groups()
+    {
+        std::scoped_lock lock(tuning_mutex);
+
+        const auto path = tuning_table_path();
+        if(path.empty())
+            return false;
+
+        if(!prepare_cache_directory(path.parent_path()))
+            return false;
+
+        std::ofstream file(path);
+        for(const auto& [kernel, entries] : tuning_table())
+        {
+            for(const auto& entry : entries)
+            {
+                file << kernel << ' '
+                     << entry.buffer_size.width << ' ' << entry.buffer_size.height << ' '
+                     << entry.local_size.width << ' ' << entry.local_size.height << '\n';
+            }
+        }
+        file.close();
+
+        return file.good() && restrict_cache_entry(path);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static size_t round_up(const int size, const int multiple)
+    {
+        return static_cast<size_t>(((size + multiple - 1) / multiple) * multiple);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void optimal_groups(const cv::UMat& buffer, size_t global_groups[3], size_t local_groups[3], const char* kernel)
     {
         // Reset all group sizings to identity.
         local_groups[0] = 1; local_groups[1] = 1; local_groups[2] = 1;
         global_groups[0] = 1; global_groups[1] = 1; global_groups[2] = 1;
 
-        // Figure out optimal and compatible 2D local and global work sizes for a kernel.
-        // Note that this is just based on rule of thumbs, rather than concrete optimality.
-        if(buffer.dims == 1 || buffer.cols == 1)
+        const bool is_1d = buffer.dims == 1 || buffer.cols == 1;
+        LVK_ASSERT(is_1d || buffer.dims == 2);
+
+        // Figure out compatible 2D local and global work sizes for a kernel. Tuned sizes are
+        // used where available, otherwise we fall back to rule of thumbs: 64x1 threads for 1D
+        // buffers and 8x8 threads for 2D buffers, rather than concrete optimality.
+        cv::Size local_size = is_1d ? cv::Size(64, 1) : cv::Size(8, 8);
+        if(kernel != nullptr)
+        {
+            if(const auto tuned_size = tuned_work_group(kernel, buffer.size()); tuned_size.has_value())
+                local_size = *tuned_size;
+        }
+
+        if(is_1d)
         {
-            // 1D buffers: default to a work group of 64x1 threads.
-            local_groups[0] = 64;
-            global_groups[0] = static_cast<size_t>(std::ceil(static_cast<float>(buffer.rows) / 64.0f)) * 64;
+            local_groups[0] = local_size.width;
+            global_groups[0] = round_up(buffer.rows, local_size.width);
         }
-        else if(buffer.dims == 2)
+        else
         {
-            // 2D buffers: default to a work group of 8x8 threads.
-            local_groups[0] = 8; local_groups[1] = 8;
-            global_groups[0] = static_cast<size_t>(std::ceil(static_cast<float>(buffer.cols) / 8.0f)) * 8;
-            global_groups[1] = static_cast<size_t>(std::ceil(static_cast<float>(buffer.rows) / 8.0f)) * 8;
+            local_groups[0] = local_size.width; local_groups[1] = local_size.height;
+            global_groups[0] = round_up(buffer.cols, local_size.width);
+            global_groups[1] = round_up(buffer.rows, local_size.height);
         }
-        else LVK_ASSERT(false && "Buffer dimensions are not supported");
     }
 
 //---------------------------------------------------------------------------------------------------------------------
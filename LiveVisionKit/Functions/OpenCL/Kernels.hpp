@@ -18,15 +18,44 @@
 #pragma once
 
 #include <vector>
+#include <optional>
+#include <filesystem>
 #include <opencv2/opencv.hpp>
 #include <opencv2/core/ocl.hpp>
 
 namespace lvk::ocl
 {
 
+    // NOTE: programs are only compiled once per context, and their binaries are
+    // cached on disk so that subsequent processes can skip compilation entirely.
     cv::ocl::Program load_program(const char* name, const char* source, const char* flags = "");
 
-    void optimal_groups(const cv::UMat& buffer, size_t global_groups[3], size_t local_groups[3]);
+    // Compiles all LVK programs ahead of time, rather than on their first use.
+    void warmup_programs();
+
+    // Defaults to a per user cache directory, which is restricted to the user on creation.
+    // NOTE: cache entries not owned by the current user are ignored. An empty directory disables the cache.
+    void set_program_cache(const std::filesystem::path& directory);
+
+    std::filesystem::path program_cache();
+
+    // NOTE: the local sizes of named kernels are taken from the work group tuning table when available.
+    void optimal_groups(
+        const cv::UMat& buffer,
+        size_t global_groups[3],
+        size_t local_groups[3],
+        const char* kernel = nullptr
+    );
+
+    // The tuning table is persisted per device alongside the program binary cache.
+    std::optional<cv::Size> tuned_work_group(const char* kernel, const cv::Size& buffer_size);
+
+    void set_work_group(const char* kernel, const cv::Size& buffer_size, const cv::Size& local_size);
+
+    bool save_work_groups();
+
+    // The conversion kernel is specialized by its channel counts, so each variant is tuned under its own name.
+    const char* conversion_kernel_key(const int src_channels, const int dst_channels);
 
     // OpenCL Kernel Sources
     namespace src
@@ -38,5 +67,9 @@ namespace lvk::ocl
         inline const char* drawing_source =
             #include "Sources/Drawing.cl"
 ;
+
+        inline const char* conversion_source =
+            #include "Sources/Conversion.cl"
+;
     }
 }
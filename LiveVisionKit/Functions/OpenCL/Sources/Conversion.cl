@@ -0,0 +1,63 @@
+R"(
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+// NOTE: SRC_CHANNELS and DST_CHANNELS must be defined at compile time.
+
+//----------------------------------------------------------------------------------------------------------------------
+
+__kernel void convert(
+    __global const uchar* src, int src_step, int src_offset, int src_rows, int src_cols,
+    __global uchar* dst, int dst_step, int dst_offset,
+    float16 transform, float4 bias
+)
+{
+    int2 coord = (int2)(get_global_id(0), get_global_id(1));
+    if(coord.x >= src_cols || coord.y >= src_rows)
+        return;
+
+    int src_index = coord.y * src_step + (SRC_CHANNELS * coord.x) + src_offset;
+    int dst_index = coord.y * dst_step + (DST_CHANNELS * coord.x) + dst_offset;
+
+#if SRC_CHANNELS == 1
+    float4 pixel = (float4)(convert_float(src[src_index]), 0.0f, 0.0f, 0.0f);
+#elif SRC_CHANNELS == 3
+    float4 pixel = (float4)(convert_float3(vload3(0, src + src_index)), 0.0f);
+#else
+    float4 pixel = convert_float4(vload4(0, src + src_index));
+#endif
+
+    // Each row of the transform produces one channel of the output.
+    uchar4 result = convert_uchar4_sat_rte((float4)(
+        dot(transform.s0123, pixel),
+        dot(transform.s4567, pixel),
+        dot(transform.s89ab, pixel),
+        dot(transform.scdef, pixel)
+    ) + bias);
+
+#if DST_CHANNELS == 1
+    dst[dst_index] = result.x;
+#elif DST_CHANNELS == 3
+    vstore3(result.xyz, 0, dst + dst_index);
+#else
+    vstore4(result, 0, dst + dst_index);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// )"
@@ -106,4 +106,47 @@ __kernel void crosses(
 
 //----------------------------------------------------------------------------------------------------------------------
 
+__kernel void lines(
+    __global uchar* pts, int pts_step, int pts_offset, int pts_rows, int pts_cols,
+    __global uchar* dst, int dst_step, int dst_offset, int dst_rows, int dst_cols,
+    int line_thickness, uchar4 line_colour
+)
+{
+    // Exit early if out of bounds (for uneven sizes)
+    if(get_global_id(0) >= pts_rows) return;
+
+    int pts_index = get_global_id(0) * pts_step + pts_offset;
+    int4 line = as_int4(vload16(0, pts + pts_index));
+
+    float2 start = convert_float2(line.xy);
+    float2 delta = convert_float2(line.zw) - start;
+
+    // Step along the line one pixel at a time
+    int steps = max((int)ceil(max(fabs(delta.x), fabs(delta.y))), 1);
+    float2 step = delta / (float)steps;
+
+    int offset = line_thickness / 2;
+    for(int i = 0; i <= steps; i++)
+    {
+        int2 centre = convert_int2_rte(start + step * (float)i);
+
+        int min_x = max(centre.x - offset, 0);
+        int min_y = max(centre.y - offset, 0);
+        int max_x = min(centre.x - offset + line_thickness, dst_cols);
+        int max_y = min(centre.y - offset + line_thickness, dst_rows);
+
+        // Draw square brush
+        for(int y = min_y; y < max_y; y++)
+        {
+            for(int x = min_x; x < max_x; x++)
+            {
+                int index = y * dst_step + (3 * x) + dst_offset;
+                vstore3(line_colour.xyz, 0, dst + index);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 // )"
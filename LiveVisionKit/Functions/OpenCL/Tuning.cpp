@@ -0,0 +1,188 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#include "Tuning.hpp"
+
+#include <span>
+#include <vector>
+#include <functional>
+
+#include "Kernels.hpp"
+#include "Directives.hpp"
+#include "Functions/Image.hpp"
+#include "Functions/Drawing.hpp"
+#include "Timing/Stopwatch.hpp"
+
+namespace lvk::ocl
+{
+
+    const cv::Size CANDIDATES_2D[] = {
+        {4, 4}, {8, 4}, {8, 8}, {16, 4}, {16, 8}, {8, 16},
+        {16, 16}, {32, 4}, {32, 8}, {64, 1}, {64, 2}, {64, 4}
+    };
+
+    const cv::Size CANDIDATES_1D[] = {
+        {16, 1}, {32, 1}, {64, 1}, {128, 1}, {256, 1}, {512, 1}
+    };
+
+    constexpr int TUNING_POINT_COUNT = 1024;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    struct TuningTarget
+    {
+        const char* kernel;
+        cv::ocl::Program program;
+        cv::Size buffer_size;
+        std::function<void()> launch;
+
+        // NOTE: the name of the kernel's tuning entry, if it differs from the kernel.
+        const char* tuning_key = nullptr;
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static Time time_launches(const std::function<void()>& launch, const uint32_t repetitions)
+    {
+        // Launch once beforehand to exclude any allocations.
+        launch();
+        cv::ocl::finish();
+
+        Stopwatch timer;
+        timer.start();
+        for(uint32_t r = 0; r < repetitions; r++)
+            launch();
+
+        return timer.sync_gpu().stop();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool tune_work_groups(const cv::Size& resolution, const uint32_t repetitions)
+    {
+        LVK_ASSERT(resolution.width > 0 && resolution.height > 0);
+        LVK_ASSERT(repetitions > 0);
+
+        if(!cv::ocl::useOpenCL())
+            return false;
+
+        const auto& device = cv::ocl::Device::getDefault();
+        if(device.empty())
+            return false;
+
+        const auto fsr_program = load_program("fsr", src::fsr_source);
+        const auto draw_program = load_program("draw", src::drawing_source);
+
+        // Create synthetic inputs, the content of which does not affect performance.
+        VideoFrame frame(cv::UMat(resolution, CV_8UC3), 0, VideoFrame::YUV);
+        cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+
+        cv::UMat small_frame;
+        cv::resize(frame, small_frame, resolution / 2, 0, 0, cv::INTER_AREA);
+
+        cv::UMat offset_map(resolution, CV_32FC2, cv::Scalar::all(0));
+        const cv::Mat homography = cv::Mat::eye(3, 3, CV_64FC1);
+
+        cv::RNG rng(1);
+        std::vector<cv::Point2f> points(TUNING_POINT_COUNT);
+        for(auto& point : points)
+        {
+            point.x = rng.uniform(0.0f, static_cast<float>(resolution.width));
+            point.y = rng.uniform(0.0f, static_cast<float>(resolution.height));
+        }
+
+        VideoFrame output, gray_frame, bgra_frame;
+        cv::UMat canvas(resolution, CV_8UC3, cv::Scalar::all(0));
+        frame.reformatTo(gray_frame, VideoFrame::GRAY);
+        frame.reformatTo(bgra_frame, VideoFrame::BGRA);
+
+        const cv::Size points_size(1, TUNING_POINT_COUNT), lines_size(1, TUNING_POINT_COUNT / 2);
+        std::vector<TuningTarget> targets = {
+            {"easu_scale", fsr_program, resolution, [&](){lvk::upscale(small_frame, output, resolution);}},
+            {"easu_remap", fsr_program, resolution, [&](){lvk::remap(frame, output, offset_map, yuv::BLACK);}},
+            {"easu_remap_homography", fsr_program, resolution, [&](){lvk::remap(frame, output, homography, yuv::BLACK);}},
+            {"rcas", fsr_program, resolution, [&](){lvk::sharpen(frame, output);}},
+            {"grid", draw_program, resolution, [&](){lvk::draw_grid(canvas, {32, 32}, yuv::MAGENTA);}},
+            {"points", draw_program, points_size, [&](){lvk::draw_points(canvas, points, yuv::MAGENTA);}},
+            {"crosses", draw_program, points_size, [&](){lvk::draw_crosses(canvas, points, yuv::MAGENTA);}},
+            {"lines", draw_program, lines_size, [&](){lvk::draw_lines(canvas, points, yuv::MAGENTA);}}
+        };
+
+        // Every channel variant of the conversion kernel is tuned, as each has its own tuning entry.
+        const std::pair<const VideoFrame&, VideoFrame::Format> conversions[] = {
+            {gray_frame, VideoFrame::BGR}, {gray_frame, VideoFrame::BGRA},
+            {frame, VideoFrame::GRAY}, {frame, VideoFrame::BGR}, {frame, VideoFrame::BGRA},
+            {bgra_frame, VideoFrame::GRAY}, {bgra_frame, VideoFrame::BGR}, {bgra_frame, VideoFrame::RGBA}
+        };
+        for(const auto& [input, format] : conversions)
+        {
+            const int src_channels = input.channels();
+            const int dst_channels = format == VideoFrame::GRAY ? 1 : (format == VideoFrame::BGR ? 3 : 4);
+
+            targets.push_back({
+                "convert",
+                load_program(
+                    "convert",
+                    src::conversion_source,
+                    cv::format("-D SRC_CHANNELS=%d -D DST_CHANNELS=%d", src_channels, dst_channels).c_str()
+                ),
+                resolution,
+                [&input, &output, format](){input.reformatTo(output, format);},
+                conversion_kernel_key(src_channels, dst_channels)
+            });
+        }
+
+        for(const auto& target : targets)
+        {
+            // Work groups must fit within the limits of both the kernel and device.
+            cv::ocl::Kernel kernel(target.kernel, target.program);
+            const size_t max_size = std::min(kernel.workGroupSize(), device.maxWorkGroupSize());
+            if(kernel.empty() || max_size == 0)
+                continue;
+
+            const char* tuning_key = target.tuning_key != nullptr ? target.tuning_key : target.kernel;
+            const bool is_1d = target.buffer_size.width == 1;
+            const auto candidates = is_1d ? std::span<const cv::Size>(CANDIDATES_1D)
+                                          : std::span<const cv::Size>(CANDIDATES_2D);
+
+            std::optional<cv::Size> best_size;
+            Time best_time;
+            for(const auto& candidate : candidates)
+            {
+                if(static_cast<size_t>(candidate.area()) > max_size)
+                    continue;
+
+                set_work_group(tuning_key, target.buffer_size, candidate);
+
+                const Time time = time_launches(target.launch, repetitions);
+                if(!best_size.has_value() || time < best_time)
+                {
+                    best_size = candidate;
+                    best_time = time;
+                }
+            }
+
+            if(best_size.has_value())
+                set_work_group(tuning_key, target.buffer_size, *best_size);
+        }
+
+        return save_work_groups();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,30 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+namespace lvk::ocl
+{
+
+    // Benchmarks candidate work group sizes of every LVK kernel on the default
+    // device at the given resolution, storing the fastest in the tuning table.
+    // NOTE: this blocks for a few seconds and should be run ahead of time.
+    bool tune_work_groups(const cv::Size& resolution, const uint32_t repetitions = 20);
+
+}
@@ -29,6 +29,8 @@
 #include "Functions/Drawing.hpp"
 #include "Functions/Container.hpp"
 #include "Functions/Extensions.hpp"
+#include "Functions/OpenCL/Kernels.hpp"
+#include "Functions/OpenCL/Tuning.hpp"
 
 
 #include "Filters/VideoFilter.hpp"
@@ -36,6 +38,7 @@
 #include "Filters/ConversionFilter.hpp"
 #include "Filters/DeblockingFilter.hpp"
 #include "Filters/StabilizationFilter.hpp"
+#include "Filters/StreamScheduler.hpp"
 
 #include "Logging/Logger.hpp"
 #include "Logging/CSVLogger.hpp"
@@ -50,11 +53,17 @@
 #include "Data/StreamBuffer.hpp"
 
 #include "Timing/Time.hpp"
+#include "Timing/TimeHistogram.hpp"
 #include "Timing/Stopwatch.hpp"
+#include "Timing/GPUStopwatch.hpp"
 #include "Timing/TickTimer.hpp"
+#include "Timing/Trace.hpp"
 
 #include "Utility/Unique.hpp"
 #include "Utility/Configurable.hpp"
+#include "Utility/TaskPool.hpp"
+#include "Utility/TaskGraph.hpp"
+#include "Utility/MemoryTracker.hpp"
 
 #include "Vision/FrameTracker.hpp"
 #include "Vision/PathSmoother.hpp"
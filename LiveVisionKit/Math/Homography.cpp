@@ -17,17 +17,69 @@
 
 #include "Homography.hpp"
 
+#include "Eigen/Core"
+
 #include "Directives.hpp"
 
 namespace lvk
 {
+    // NOTE: matches the threshold used by cv::perspectiveTransform.
+    constexpr double PERSPECTIVE_EPSILON = FLT_EPSILON;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline cv::Point_<T> perspective_transform(const cv::Matx33d& matrix, const cv::Point_<T>& point)
+    {
+        const double x = point.x, y = point.y;
+        const double w = matrix(2,0) * x + matrix(2,1) * y + matrix(2,2);
+
+        if(std::abs(w) <= PERSPECTIVE_EPSILON)
+            return {0, 0};
+
+        return cv::Point_<T>(
+            static_cast<T>((matrix(0,0) * x + matrix(0,1) * y + matrix(0,2)) / w),
+            static_cast<T>((matrix(1,0) * x + matrix(1,1) * y + matrix(1,2)) / w)
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename T>
+    inline void perspective_transform(
+        const cv::Matx33d& matrix,
+        const std::vector<cv::Point_<T>>& points,
+        std::vector<cv::Point_<T>>& dst
+    )
+    {
+        using PointMatrix = Eigen::Matrix<T, 2, Eigen::Dynamic>;
+        const auto count = static_cast<Eigen::Index>(points.size());
+
+        // NOTE: the points are interleaved in memory so they can be mapped
+        // directly as the columns of a 2xN matrix. The transform is then
+        // evaluated in double precision over whole rows at a time, letting
+        // Eigen vectorise it. Results are written only once fully evaluated,
+        // so the transform remains valid when points and dst alias.
+        const Eigen::Map<const PointMatrix> src_points(reinterpret_cast<const T*>(points.data()), 2, count);
+        const Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>> h(matrix.val);
+
+        const Eigen::Matrix<double, 3, Eigen::Dynamic> projected =
+            (h.leftCols<2>() * src_points.template cast<double>()).colwise() + h.col(2);
+
+        const Eigen::Array<double, 1, Eigen::Dynamic> w = projected.row(2).array();
+        const Eigen::Array<double, 1, Eigen::Dynamic> w_inverse = (w.abs() > PERSPECTIVE_EPSILON).select(w.inverse(), 0.0);
+
+        dst.resize(points.size());
+        Eigen::Map<PointMatrix> dst_points(reinterpret_cast<T*>(dst.data()), 2, count);
+        dst_points = (projected.topRows<2>().array().rowwise() * w_inverse).matrix().template cast<T>();
+    }
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	const Homography& Homography::Identity()
 	{
 		// NOTE: A default-initialised homography is identity
-        thread_local const Homography identity;
+        static const Homography identity;
 		return identity;
 	}
 
@@ -35,7 +87,7 @@ namespace lvk
 
 	const Homography& Homography::Zero()
 	{
-        thread_local const Homography zero(cv::Mat::zeros(3, 3, CV_64FC1));
+        static const Homography zero(cv::Matx33d::zeros());
         return zero;
 	}
 
@@ -51,7 +103,7 @@ namespace lvk
 		Homography perspective;
 		for(int r = 0; r < 2; r++)
 			for(int c = 0; c < 3; c++)
-                perspective.m_Matrix.at<double>(r, c) = affine.at<double>(r, c);
+                perspective.m_Matrix(r, c) = affine.at<double>(r, c);
 
 		return perspective;
 	}
@@ -59,7 +111,7 @@ namespace lvk
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography::Homography()
-		: m_Matrix(cv::Mat::eye(3, 3, CV_64FC1))
+		: Homography(cv::Matx33d::eye())
 	{}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -71,62 +123,60 @@ namespace lvk
 //---------------------------------------------------------------------------------------------------------------------
 
     Homography::Homography(Homography&& other) noexcept
-        : m_Matrix(std::move(other.m_Matrix))
+        : Homography(other.m_Matrix)
     {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography::Homography(const cv::Mat& matrix)
-		: m_Matrix(matrix.clone())
+		: Homography()
 	{
 		LVK_ASSERT(matrix.cols == 3);
 		LVK_ASSERT(matrix.rows == 3);
 		LVK_ASSERT(matrix.type() == CV_64FC1);
+
+        matrix.copyTo(m_View);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     Homography::Homography(cv::Mat&& matrix) noexcept
-        : m_Matrix(std::move(matrix))
-    {
-        LVK_ASSERT(m_Matrix.cols == 3);
-        LVK_ASSERT(m_Matrix.rows == 3);
-        LVK_ASSERT(m_Matrix.type() == CV_64FC1);
-    }
+        : Homography(static_cast<const cv::Mat&>(matrix))
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Homography::Homography(const cv::Matx33d& matrix)
+        : m_Matrix(matrix),
+          m_View(3, 3, CV_64FC1, m_Matrix.val)
+    {}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::set_zero()
     {
-        m_Matrix.setTo(cv::Scalar::all(0.0));
+        m_Matrix = cv::Matx33d::zeros();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::set_identity()
     {
-        set_zero();
-        m_Matrix.at<double>(0,0) = 1.0;
-        m_Matrix.at<double>(1,1) = 1.0;
-        m_Matrix.at<double>(2,2) = 1.0;
+        m_Matrix = cv::Matx33d::eye();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	cv::Point2d Homography::transform(const cv::Point2d& point) const
 	{
-		std::vector<cv::Point2d> out, in = {point};
-		cv::perspectiveTransform(in, out, m_Matrix);
-		return out[0];
+		return perspective_transform(m_Matrix, point);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     cv::Point2f Homography::transform(const cv::Point2f& point) const
     {
-        std::vector<cv::Point2f> out, in = {point};
-        cv::perspectiveTransform(in, out, m_Matrix);
-        return out[0];
+        return perspective_transform(m_Matrix, point);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -147,14 +197,14 @@ namespace lvk
 
 	void Homography::transform(const std::vector<cv::Point2d>& points, std::vector<cv::Point2d>& dst) const
 	{
-        cv::perspectiveTransform(points, dst, m_Matrix);
+        perspective_transform(m_Matrix, points, dst);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::transform(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& dst) const
     {
-        cv::perspectiveTransform(points, dst, m_Matrix);
+        perspective_transform(m_Matrix, points, dst);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -186,7 +236,7 @@ namespace lvk
 	void Homography::warp(const cv::UMat& src, cv::UMat& dst) const
 	{
 		if(is_affine())
-			cv::warpAffine(src, dst, m_Matrix.rowRange(0, 2), src.size());
+			cv::warpAffine(src, dst, m_Matrix.get_minor<2, 3>(0, 0), src.size());
 		else
 			cv::warpPerspective(src, dst, m_Matrix, src.size());
 	}
@@ -195,24 +245,28 @@ namespace lvk
 
 	const cv::Mat& Homography::data() const
 	{
-		return m_Matrix;
+		return m_View;
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    const cv::Matx33d& Homography::matrix() const
+    {
+        return m_Matrix;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     Homography Homography::invert() const
     {
-        cv::Mat result = m_Matrix.inv();
-        return Homography(result);
+        return Homography(m_Matrix.inv());
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     bool Homography::is_identity() const
     {
-        return m_Matrix.at<cv::Vec3d>(0,0) == cv::Vec3d(1.0, 0.0, 0.0)
-            && m_Matrix.at<cv::Vec3d>(1,0) == cv::Vec3d(0.0, 1.0, 0.0)
-            && m_Matrix.at<cv::Vec3d>(2,0) == cv::Vec3d(0.0, 0.0, 1.0);
+        return m_Matrix == cv::Matx33d::eye();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -220,23 +274,25 @@ namespace lvk
 	bool Homography::is_affine() const
 	{
 		// We consider the homography affine if the bottom row is unchanged from identity
-		return m_Matrix.at<cv::Vec3d>(2, 0) == cv::Vec3d(0.0, 0.0, 1.0);
+		return m_Matrix(2,0) == 0.0 && m_Matrix(2,1) == 0.0 && m_Matrix(2,2) == 1.0;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     bool Homography::is_zero() const
     {
-        return m_Matrix.at<cv::Vec3d>(0,0) == cv::Vec3d(0.0, 0.0, 0.0)
-            && m_Matrix.at<cv::Vec3d>(1,0) == cv::Vec3d(0.0, 0.0, 0.0)
-            && m_Matrix.at<cv::Vec3d>(2,0) == cv::Vec3d(0.0, 0.0, 0.0);
+        return m_Matrix == cv::Matx33d::zeros();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     Homography& Homography::operator=(const cv::Mat& other)
     {
-        m_Matrix = other.clone();
+        LVK_ASSERT(other.cols == 3);
+        LVK_ASSERT(other.rows == 3);
+        LVK_ASSERT(other.type() == CV_64FC1);
+
+        other.copyTo(m_View);
         return *this;
     }
 
@@ -244,15 +300,14 @@ namespace lvk
 
     Homography& Homography::operator=(cv::Mat&& other) noexcept
     {
-        m_Matrix = std::move(other);
-        return *this;
+        return *this = static_cast<const cv::Mat&>(other);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     Homography& Homography::operator=(const Homography& other)
 	{
-		m_Matrix = other.m_Matrix.clone();
+		m_Matrix = other.m_Matrix;
         return *this;
 	}
 
@@ -260,7 +315,7 @@ namespace lvk
 
     Homography& Homography::operator=(Homography&& other) noexcept
 	{
-		m_Matrix = std::move(other.m_Matrix);
+		m_Matrix = other.m_Matrix;
         return *this;
     }
 
@@ -268,28 +323,28 @@ namespace lvk
 
 	void Homography::operator+=(const Homography& other)
 	{
-		cv::add(m_Matrix, other.m_Matrix, m_Matrix);
+		m_Matrix += other.m_Matrix;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::operator+=(const cv::Mat& other)
     {
-        cv::add(m_Matrix, other, m_Matrix);
+        *this += Homography(other);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	void Homography::operator-=(const Homography& other)
 	{
-		cv::subtract(m_Matrix, other.m_Matrix, m_Matrix);
+		m_Matrix -= other.m_Matrix;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::operator-=(const cv::Mat& other)
     {
-        cv::subtract(m_Matrix, other, m_Matrix);
+        *this -= Homography(other);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -297,15 +352,14 @@ namespace lvk
 	void Homography::operator*=(const Homography& other)
 	{
         // This is matrix multiplication
-        cv::gemm(m_Matrix, other.m_Matrix, 1, cv::Mat(), 0, m_Matrix, 0);
+        m_Matrix = m_Matrix * other.m_Matrix;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
     void Homography::operator*=(const cv::Mat& other)
     {
-        // This is matrix multiplication
-        cv::gemm(m_Matrix, other, 1, cv::Mat(), 0, m_Matrix, 0);
+        *this *= Homography(other);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -321,23 +375,21 @@ namespace lvk
 	{
 		LVK_ASSERT(scaling != 0.0);
 
-		m_Matrix /= scaling;
+		m_Matrix *= 1.0 / scaling;
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography operator+(const Homography& left, const Homography& right)
 	{
-        cv::Mat result = left.data() + right.data();
-		return Homography(std::move(result));
+        return Homography(left.matrix() + right.matrix());
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography operator-(const Homography& left, const Homography& right)
 	{
-        cv::Mat result = left.data() - right.data();
-        return Homography(std::move(result));
+        return Homography(left.matrix() - right.matrix());
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -345,16 +397,14 @@ namespace lvk
 	Homography operator*(const Homography& left, const Homography& right)
 	{
         // This is matrix multiplication
-        cv::Mat result = left.data() * right.data();
-        return Homography(std::move(result));
+        return Homography(left.matrix() * right.matrix());
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
 
 	Homography operator*(const Homography& homography, const double scaling)
 	{
-		cv::Mat result = homography.data() * scaling;
-        return Homography(std::move(result));
+        return Homography(homography.matrix() * scaling);
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -363,8 +413,7 @@ namespace lvk
 	{
 		LVK_ASSERT(scaling != 0.0);
 
-        cv::Mat result = homography.data() / scaling;
-        return Homography(std::move(result));
+        return Homography(homography.matrix() * (1.0 / scaling));
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -44,6 +44,8 @@ namespace lvk
 
         explicit Homography(cv::Mat&& matrix) noexcept;
 
+        explicit Homography(const cv::Matx33d& matrix);
+
 
         void set_zero();
 
@@ -73,6 +75,8 @@ namespace lvk
 
         const cv::Mat& data() const;
 
+        const cv::Matx33d& matrix() const;
+
         Homography invert() const;
 
         bool is_identity() const;
@@ -108,7 +112,10 @@ namespace lvk
 		void operator/=(const double scaling);
 
 	private:
-		cv::Mat m_Matrix;
+		cv::Matx33d m_Matrix;
+
+        // NOTE: header over m_Matrix for OpenCV functions taking a cv::Mat.
+        cv::Mat m_View;
 	};
 
 	Homography operator+(const Homography& left, const Homography& right);
@@ -209,46 +209,6 @@ namespace lvk
         return key_to_point(index_to_key(index));
     }
 
-//---------------------------------------------------------------------------------------------------------------------
-
-    void VirtualGrid::for_each(
-        const std::function<void(const int index, const cv::Point& coord)>& operation
-    ) const
-    {
-        // TODO: add parallel option.
-        int index = 0;
-        for(int r = 0; r < m_Resolution.height; r++)
-        {
-            for(int c = 0; c < m_Resolution.width; c++)
-            {
-                operation(
-                    index++,
-                    cv::Point(c, r)
-                );
-            }
-        }
-    }
-
-//---------------------------------------------------------------------------------------------------------------------
-
-    void VirtualGrid::for_each_aligned(
-        const std::function<void(const int index, const cv::Point2f& coord)>& operation
-    ) const
-    {
-        // TODO: add parallel option.
-        int index = 0;
-        for(int r = 0; r < m_Resolution.height; r++)
-        {
-            for(int c = 0; c < m_Resolution.width; c++)
-            {
-                operation(
-                    index++,
-                    cv::Point2f(static_cast<float>(c) * m_KeySize.width, static_cast<float>(r) * m_KeySize.height)
-                );
-            }
-        }
-    }
-
 //---------------------------------------------------------------------------------------------------------------------
 
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+namespace lvk
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename Operation>
+    inline void VirtualGrid::for_each(Operation&& operation) const
+    {
+        // NOTE: iteration is serial and in row-major order, as
+        // callers are allowed to depend on the index ordering.
+        int index = 0;
+        for(int r = 0; r < m_Resolution.height; r++)
+        {
+            for(int c = 0; c < m_Resolution.width; c++)
+            {
+                operation(
+                    index++,
+                    cv::Point(c, r)
+                );
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename Operation>
+    inline void VirtualGrid::for_each_aligned(Operation&& operation) const
+    {
+        // NOTE: iteration is serial and in row-major order, as
+        // callers are allowed to depend on the index ordering.
+        int index = 0;
+        for(int r = 0; r < m_Resolution.height; r++)
+        {
+            for(int c = 0; c < m_Resolution.width; c++)
+            {
+                operation(
+                    index++,
+                    cv::Point2f(static_cast<float>(c) * m_KeySize.width, static_cast<float>(r) * m_KeySize.height)
+                );
+            }
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -18,6 +18,7 @@
 #include "WarpMesh.hpp"
 
 #include <opencv2/core/ocl.hpp>
+#include <algorithm>
 #include <array>
 
 #include "Functions/Extensions.hpp"
@@ -32,25 +33,28 @@ namespace lvk
 //---------------------------------------------------------------------------------------------------------------------
 
     WarpMesh::WarpMesh(const cv::Size& size)
-        : m_MeshOffsets(size, CV_32FC2)
     {
         LVK_ASSERT(size.height >= MinimumSize.height);
         LVK_ASSERT(size.width >= MinimumSize.width);
 
+        allocate(size);
         set_identity();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     WarpMesh::WarpMesh(const WarpMesh& other)
-        : m_MeshOffsets(other.m_MeshOffsets.clone())
-    {}
+    {
+        allocate(other.size());
+        other.m_MeshOffsets.copyTo(m_MeshOffsets);
+    }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     WarpMesh::WarpMesh(WarpMesh&& other) noexcept
-        : m_MeshOffsets(std::move(other.m_MeshOffsets))
-    {}
+    {
+        *this = std::move(other);
+    }
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -69,11 +73,35 @@ namespace lvk
 //---------------------------------------------------------------------------------------------------------------------
 
     WarpMesh::WarpMesh(const Homography& motion, const cv::Size2f& motion_scale, const cv::Size& size)
-        : m_MeshOffsets(size, CV_32FC2)
     {
+        LVK_ASSERT(size.height >= MinimumSize.height);
+        LVK_ASSERT(size.width >= MinimumSize.width);
+
+        allocate(size);
         set_to(motion, motion_scale);
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void WarpMesh::allocate(const cv::Size& size)
+    {
+        // Small meshes are backed by the inline storage to avoid heap allocations,
+        // while larger meshes fall back to a regular heap allocated offset matrix.
+        if(size.area() <= InlineCapacity)
+        {
+            if(!is_inline() || m_MeshOffsets.size() != size)
+                m_MeshOffsets = cv::Mat(size, CV_32FC2, m_InlineStorage.data());
+        }
+        else m_MeshOffsets.create(size, CV_32FC2);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool WarpMesh::is_inline() const
+    {
+        return m_MeshOffsets.data == reinterpret_cast<const uchar*>(m_InlineStorage.data());
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void WarpMesh::resize(const cv::Size& new_size)
@@ -86,7 +114,7 @@ namespace lvk
 
         cv::Mat new_offsets;
         cv::resize(m_MeshOffsets, new_offsets, new_size, 0, 0, cv::INTER_LINEAR_EXACT);
-        m_MeshOffsets = std::move(new_offsets);
+        set_to(std::move(new_offsets), true, true);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -186,10 +214,13 @@ namespace lvk
 
         if(m_MeshOffsets.size() != MinimumSize)
         {
+            if(m_WarpMap == nullptr)
+                m_WarpMap = std::make_unique<cv::UMat>(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
+
             // If our mesh is larger than 2x2 then scale it up and remap the input.
-            cv::resize(m_MeshOffsets, m_WarpMap, src.size(), 0, 0, cv::INTER_LINEAR_EXACT);
-            cv::multiply(m_WarpMap, motion_scaling, m_WarpMap);
-            lvk::remap(src, dst, m_WarpMap, background);
+            cv::resize(m_MeshOffsets, *m_WarpMap, src.size(), 0, 0, cv::INTER_LINEAR_EXACT);
+            cv::multiply(*m_WarpMap, motion_scaling, *m_WarpMap);
+            lvk::remap(src, dst, *m_WarpMap, background);
         }
         else
         {
@@ -224,7 +255,6 @@ namespace lvk
 
 //---------------------------------------------------------------------------------------------------------------------
 
-    // TODO: optimize this
     void WarpMesh::draw(cv::UMat& dst, const cv::Scalar& color, const int thickness) const
     {
         LVK_ASSERT(thickness > 0);
@@ -233,84 +263,24 @@ namespace lvk
         const cv::Size2f motion_scale(dst.size());
         const cv::Size2f frame_scaling = cv::Size2f(dst.size()) / cv::Size2f(size() - 1);
 
-        thread_local cv::UMat gpu_draw_mask(cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY);
-        cv::Mat draw_mask;
-
-        draw_mask.create(dst.size(), CV_8UC1);
-        draw_mask.setTo(cv::Scalar(0));
+        // Gather the motion vectors as pairs of line end points. As read() may run
+        // in parallel, the workers must capture a plain reference to this buffer.
+        thread_local std::vector<cv::Point2f> motion_line_cache;
+        auto& motion_lines = motion_line_cache;
+        motion_lines.resize(2 * m_MeshOffsets.total());
 
-        // Draw all the motion vectors
         read([&](const cv::Point2f& offset, const cv::Point& coord){
             const cv::Point2f origin(
                 static_cast<float>(coord.x) * frame_scaling.width,
                 static_cast<float>(coord.y) * frame_scaling.height
             );
 
-            cv::line(
-                draw_mask,
-                origin,
-                origin - offset * motion_scale,
-                cv::Scalar(255),
-                thickness
-            );
+            const size_t index = 2 * static_cast<size_t>(coord.y * m_MeshOffsets.cols + coord.x);
+            motion_lines[index] = origin;
+            motion_lines[index + 1] = origin - offset * motion_scale;
         });
 
-        draw_mask.copyTo(gpu_draw_mask);
-        dst.setTo(color, gpu_draw_mask);
-    }
-
-//---------------------------------------------------------------------------------------------------------------------
-
-    void WarpMesh::read(
-        const std::function<void(const cv::Point2f&, const cv::Point&)>& operation,
-        const bool parallel
-    ) const
-    {
-        if(parallel)
-        {
-            // NOTE: this uses a parallel loop internally
-            m_MeshOffsets.forEach<cv::Point2f>([&](const cv::Point2f& value, const int coord[]){
-                operation(value, {coord[1], coord[0]});
-            });
-        }
-        else
-        {
-            for(int r = 0; r < m_MeshOffsets.rows; r++)
-            {
-                const auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
-                for(int c = 0; c < m_MeshOffsets.cols; c++)
-                {
-                    operation(row_ptr[c], {c, r});
-                }
-            }
-        }
-    }
-
-//---------------------------------------------------------------------------------------------------------------------
-
-    void WarpMesh::write(
-        const std::function<void(cv::Point2f&, const cv::Point&)>& operation,
-        const bool parallel
-    )
-    {
-        if(parallel)
-        {
-            // NOTE: this uses a parallel loop internally
-            m_MeshOffsets.forEach<cv::Point2f>([&](cv::Point2f& value, const int coord[]){
-                operation(value, {coord[1], coord[0]});
-            });
-        }
-        else
-        {
-            for(int r = 0; r < m_MeshOffsets.rows; r++)
-            {
-                auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
-                for(int c = 0; c < m_MeshOffsets.cols; c++)
-                {
-                    operation(row_ptr[c], {c, r});
-                }
-            }
-        }
+        draw_lines(dst, motion_lines, color, thickness);
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -347,7 +317,14 @@ namespace lvk
     {
         LVK_ASSERT(warp_map.type() == CV_32FC2);
 
-        m_MeshOffsets = std::move(warp_map);
+        // Small maps are copied into the inline storage instead of being adopted.
+        if(warp_map.size().area() <= InlineCapacity)
+        {
+            allocate(warp_map.size());
+            warp_map.copyTo(m_MeshOffsets);
+        }
+        else m_MeshOffsets = std::move(warp_map);
+
         if(!as_offsets) cv::subtract(m_MeshOffsets, view_identity_mesh(m_MeshOffsets.size()), m_MeshOffsets);
         if(!normalized) normalize(m_MeshOffsets.size());
     }
@@ -358,6 +335,7 @@ namespace lvk
     {
         LVK_ASSERT(warp_map.type() == CV_32FC2);
 
+        allocate(warp_map.size());
         warp_map.copyTo(m_MeshOffsets);
         if(!as_offsets) cv::subtract(m_MeshOffsets, view_identity_mesh(m_MeshOffsets.size()), m_MeshOffsets);
         if(!normalized) normalize(m_MeshOffsets.size());
@@ -474,7 +452,16 @@ namespace lvk
 
     WarpMesh& WarpMesh::operator=(WarpMesh&& other) noexcept
     {
-        m_MeshOffsets = std::move(other.m_MeshOffsets);
+        if(this == &other)
+            return *this;
+
+        // Inline storage cannot be moved, so its vertices must be copied instead.
+        if(other.is_inline())
+        {
+            allocate(other.size());
+            std::copy_n(other.m_InlineStorage.begin(), other.m_MeshOffsets.total(), m_InlineStorage.begin());
+        }
+        else m_MeshOffsets = std::move(other.m_MeshOffsets);
 
         return *this;
     }
@@ -483,6 +470,7 @@ namespace lvk
 
     WarpMesh& WarpMesh::operator=(const WarpMesh& other)
     {
+        allocate(other.size());
         other.m_MeshOffsets.copyTo(m_MeshOffsets);
 
         return *this;
@@ -565,8 +553,9 @@ namespace lvk
     {
         LVK_ASSERT(left.size() == right.size());
 
-        cv::Mat result = left.offsets() + right.offsets();
-        return WarpMesh(std::move(result), true, true);
+        WarpMesh result(left);
+        result += right;
+        return result;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -575,8 +564,9 @@ namespace lvk
     {
         LVK_ASSERT(left.size() == right.size());
 
-        cv::Mat result = left.offsets() - right.offsets();
-        return WarpMesh(std::move(result), true, true);
+        WarpMesh result(left);
+        result -= right;
+        return result;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -592,16 +582,18 @@ namespace lvk
 
     WarpMesh operator+(const WarpMesh& left, const cv::Point2f& right)
     {
-        cv::Mat result = left.offsets() + cv::Scalar(right.x, right.y);
-        return WarpMesh(std::move(result), true, true);
+        WarpMesh result(left);
+        result += right;
+        return result;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
 
     WarpMesh operator-(const WarpMesh& left, const cv::Point2f& right)
     {
-        cv::Mat result = left.offsets() - cv::Scalar(right.x, right.y);
-        return WarpMesh(std::move(result), true, true);
+        WarpMesh result(left);
+        result -= right;
+        return result;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -642,8 +634,9 @@ namespace lvk
 
     WarpMesh operator*(const WarpMesh& mesh, const float scaling)
     {
-        cv::Mat result = mesh.offsets() * scaling;
-        return WarpMesh(std::move(result), true, true);
+        WarpMesh result(mesh);
+        result *= scaling;
+        return result;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -659,8 +652,9 @@ namespace lvk
     {
         LVK_ASSERT(scaling != 0.0f);
 
-        cv::Mat result = mesh.offsets() / scaling;
-        return WarpMesh(std::move(result), true, true);
+        WarpMesh result(mesh);
+        result /= scaling;
+        return result;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -17,13 +17,15 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
 #include <optional>
-#include <functional>
 #include <opencv2/opencv.hpp>
 
 #include "Math/Homography.hpp"
 #include "Data/VideoFrame.hpp"
 #include "Functions/Drawing.hpp"
+#include "Utility/TaskPool.hpp"
 
 namespace lvk
 {
@@ -34,6 +36,12 @@ namespace lvk
 
         inline static const cv::Size MinimumSize = {2,2};
 
+        // Meshes with up to this many vertices are stored inline, without allocation.
+        static constexpr int InlineCapacity = 16 * 16;
+
+        // Meshes with fewer vertices than this are always read and written serially.
+        static constexpr int ParallelThreshold = 32 * 32;
+
 
         explicit WarpMesh(const cv::Size& size);
 
@@ -82,15 +90,13 @@ namespace lvk
         void draw(cv::UMat& dst, const cv::Scalar& color = yuv::MAGENTA, const int thickness = 2) const;
 
 
-        void read(
-            const std::function<void(const cv::Point2f& offset, const cv::Point& coord)>& operation,
-            const bool parallel = true
-        ) const;
+        // Operation: void(const cv::Point2f& offset, const cv::Point& coord)
+        template<typename Operation>
+        void read(Operation&& operation, const bool parallel = true) const;
 
-        void write(
-            const std::function<void(cv::Point2f& offset, const cv::Point& coord)>& operation,
-            const bool parallel = true
-        );
+        // Operation: void(cv::Point2f& offset, const cv::Point& coord)
+        template<typename Operation>
+        void write(Operation&& operation, const bool parallel = true);
 
 
         void set_identity();
@@ -152,12 +158,20 @@ namespace lvk
 
         static const cv::Mat view_identity_mesh(const cv::Size& resolution);
 
+        void allocate(const cv::Size& size);
+
+        bool is_inline() const;
+
     private:
         // Offsets map mesh vertices from warped coord to identity coord.
         // e.g. Mesh Offsets = Warped Mesh - Identity Grid.
         cv::Mat m_MeshOffsets;
 
-        mutable cv::UMat m_WarpMap{cv::UMatUsageFlags::USAGE_ALLOCATE_DEVICE_MEMORY};
+        // NOTE: small meshes are viewed through m_MeshOffsets and cannot be moved.
+        alignas(16) std::array<cv::Point2f, InlineCapacity> m_InlineStorage;
+
+        // NOTE: only created once the mesh is applied to a frame.
+        mutable std::unique_ptr<cv::UMat> m_WarpMap = nullptr;
     };
 
     WarpMesh operator+(const WarpMesh& left, const WarpMesh& right);
@@ -189,3 +203,5 @@ namespace lvk
     WarpMesh operator/(const float scaling, const WarpMesh& mesh);
 
 }
+
+#include "WarpMesh.tpp"
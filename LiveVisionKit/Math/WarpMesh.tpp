@@ -0,0 +1,71 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+namespace lvk
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename Operation>
+    inline void WarpMesh::read(Operation&& operation, const bool parallel) const
+    {
+        // NOTE: the parallel loop has a large dispatch overhead relative to
+        // the per-vertex operation, so it is only used on larger meshes.
+        const auto read_rows = [&](const cv::Range& rows){
+            for(int r = rows.start; r < rows.end; r++)
+            {
+                const auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
+                for(int c = 0; c < m_MeshOffsets.cols; c++)
+                {
+                    operation(row_ptr[c], cv::Point(c, r));
+                }
+            }
+        };
+
+        if(parallel && m_MeshOffsets.total() >= ParallelThreshold)
+            parallel_for(cv::Range(0, m_MeshOffsets.rows), read_rows);
+        else
+            read_rows(cv::Range(0, m_MeshOffsets.rows));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    template<typename Operation>
+    inline void WarpMesh::write(Operation&& operation, const bool parallel)
+    {
+        // NOTE: the parallel loop has a large dispatch overhead relative to
+        // the per-vertex operation, so it is only used on larger meshes.
+        const auto write_rows = [&](const cv::Range& rows){
+            for(int r = rows.start; r < rows.end; r++)
+            {
+                auto* row_ptr = m_MeshOffsets.ptr<cv::Point2f>(r);
+                for(int c = 0; c < m_MeshOffsets.cols; c++)
+                {
+                    operation(row_ptr[c], cv::Point(c, r));
+                }
+            }
+        };
+
+        if(parallel && m_MeshOffsets.total() >= ParallelThreshold)
+            parallel_for(cv::Range(0, m_MeshOffsets.rows), write_rows);
+        else
+            write_rows(cv::Range(0, m_MeshOffsets.rows));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
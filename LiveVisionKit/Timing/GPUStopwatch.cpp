@@ -0,0 +1,230 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#include "GPUStopwatch.hpp"
+
+#include <atomic>
+#include <opencv2/core/ocl.hpp>
+
+#define CL_TARGET_OPENCL_VERSION 120
+#include <CL/cl.h>
+
+#include "Directives.hpp"
+#include "Functions/Container.hpp"
+
+namespace lvk
+{
+    // Unresolved intervals past this limit are dropped, as their markers have likely failed.
+    constexpr size_t MAX_PENDING_INTERVALS = 64;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    struct GPUStopwatch::Marker
+    {
+        cl_event event = nullptr;
+
+        // NOTE: only used when the queue was created without profiling.
+        std::atomic<int64_t> host_completion_time = -1;
+
+        ~Marker()
+        {
+            if(event != nullptr)
+                clReleaseEvent(event);
+        }
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    GPUStopwatch::GPUStopwatch(const size_t history)
+        : m_History(history)
+    {
+        LVK_ASSERT(history > 0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GPUStopwatch::start()
+    {
+        resolve();
+
+        m_StartMarker = enqueue_marker();
+        m_Running = m_StartMarker != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GPUStopwatch::stop()
+    {
+        if(!is_running())
+            return;
+
+        m_Running = false;
+        if(auto end_marker = enqueue_marker(); end_marker != nullptr)
+        {
+            m_Pending.emplace_back(std::move(m_StartMarker), std::move(end_marker));
+
+            // Drop the oldest intervals if the queue is not making progress.
+            while(m_Pending.size() > MAX_PENDING_INTERVALS)
+                m_Pending.pop_front();
+        }
+        m_StartMarker.reset();
+
+        resolve();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GPUStopwatch::resolve()
+    {
+        // NOTE: the queue is in-order, so intervals complete in the order they were recorded.
+        while(!m_Pending.empty())
+        {
+            const auto& [start_marker, end_marker] = m_Pending.front();
+
+            const auto end_time = completion_time(*end_marker);
+            const auto start_time = completion_time(*start_marker);
+            if(!start_time.has_value() || !end_time.has_value())
+                break;
+
+            m_History.push(Time(*end_time > *start_time ? *end_time - *start_time : 0));
+            m_Pending.pop_front();
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool GPUStopwatch::is_running() const
+    {
+        return m_Running;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t GPUStopwatch::pending() const
+    {
+        return m_Pending.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Time GPUStopwatch::average() const
+    {
+        return m_History.is_empty() ? Time(0) : mean(m_History.begin(), m_History.end());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Time GPUStopwatch::deviation() const
+    {
+        if(m_History.size() < 2)
+            return Time(0);
+
+        const Time average_time = average();
+
+        Time total_deviation(0);
+        for(auto current_time : m_History)
+        {
+            if(average_time > current_time)
+                total_deviation += average_time - current_time;
+            else
+                total_deviation += current_time - average_time;
+        }
+
+        return total_deviation / static_cast<double>(m_History.size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GPUStopwatch::reset_history()
+    {
+        m_History.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const StreamBuffer<Time>& GPUStopwatch::history() const
+    {
+        return m_History;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void GPUStopwatch::set_history_size(const size_t history)
+    {
+        LVK_ASSERT(history >= 1);
+
+        m_History.resize(history);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<GPUStopwatch::Marker> GPUStopwatch::enqueue_marker()
+    {
+        if(!cv::ocl::useOpenCL())
+            return nullptr;
+
+        auto queue = static_cast<cl_command_queue>(cv::ocl::Queue::getDefault().ptr());
+        if(queue == nullptr)
+            return nullptr;
+
+        auto marker = std::make_shared<Marker>();
+        if(clEnqueueMarkerWithWaitList(queue, 0, nullptr, &marker->event) != CL_SUCCESS)
+            return nullptr;
+
+        // Record the host time of completion in case the queue has no profiling
+        // support. The callback holds a reference so the marker outlives it.
+        const auto callback = [](cl_event, cl_int, void* data){
+            auto* marker_ref = static_cast<std::shared_ptr<Marker>*>(data);
+            (*marker_ref)->host_completion_time = static_cast<int64_t>(Time::Now().nanoseconds());
+            delete marker_ref;
+        };
+
+        auto* marker_ref = new std::shared_ptr<Marker>(marker);
+        if(clSetEventCallback(marker->event, CL_COMPLETE, callback, marker_ref) != CL_SUCCESS)
+            delete marker_ref;
+
+        // Submit the marker without waiting on the queue.
+        clFlush(queue);
+
+        return marker;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<uint64_t> GPUStopwatch::completion_time(const Marker& marker)
+    {
+        cl_int status = CL_QUEUED;
+        clGetEventInfo(marker.event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status), &status, nullptr);
+        if(status != CL_COMPLETE)
+            return std::nullopt;
+
+        // Prefer the device timestamps, which are only available on profiling queues.
+        cl_ulong device_time = 0;
+        if(clGetEventProfilingInfo(marker.event, CL_PROFILING_COMMAND_END, sizeof(device_time), &device_time, nullptr) == CL_SUCCESS)
+            return static_cast<uint64_t>(device_time);
+
+        // Otherwise fall back to the host time of completion, once the callback has run.
+        const int64_t host_time = marker.host_completion_time;
+        if(host_time < 0)
+            return std::nullopt;
+
+        return static_cast<uint64_t>(host_time);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,76 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <optional>
+
+#include "Time.hpp"
+#include "Data/StreamBuffer.hpp"
+
+namespace lvk
+{
+
+    // NOTE: Times work submitted to the default OpenCL queue by recording
+    // event markers, rather than synchronizing the queue. The durations are
+    // only resolved once the markers complete, so the history lags behind.
+    class GPUStopwatch
+    {
+    public:
+
+        explicit GPUStopwatch(const size_t history = 1);
+
+        void start();
+
+        void stop();
+
+        void resolve();
+
+
+        bool is_running() const;
+
+        size_t pending() const;
+
+
+        Time average() const;
+
+        Time deviation() const;
+
+
+        void reset_history();
+
+        const StreamBuffer<Time>& history() const;
+
+        void set_history_size(const size_t history);
+
+    private:
+        struct Marker;
+
+        static std::shared_ptr<Marker> enqueue_marker();
+
+        static std::optional<uint64_t> completion_time(const Marker& marker);
+
+    private:
+        bool m_Running = false;
+        StreamBuffer<Time> m_History;
+        std::shared_ptr<Marker> m_StartMarker;
+        std::deque<std::pair<std::shared_ptr<Marker>, std::shared_ptr<Marker>>> m_Pending;
+    };
+
+}
@@ -54,6 +54,7 @@ namespace lvk
         {
             m_ElapsedTime = pause();
             m_History.push(m_ElapsedTime);
+            m_Histogram.record(m_ElapsedTime);
 
             m_Memory = Time(0);
 
@@ -170,6 +171,7 @@ namespace lvk
     void Stopwatch::reset_history()
     {
         m_History.clear();
+        m_Histogram.reset();
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -179,6 +181,13 @@ namespace lvk
 		return m_History;
 	}
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    const TimeHistogram& Stopwatch::histogram() const
+    {
+        return m_Histogram;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void Stopwatch::set_history_size(const size_t history)
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "Time.hpp"
+#include "TimeHistogram.hpp"
 #include "Data/StreamBuffer.hpp"
 
 namespace lvk
@@ -58,11 +59,15 @@ namespace lvk
 
 		const StreamBuffer<Time>& history() const;
 
+        // NOTE: holds every sample since the last history reset.
+        const TimeHistogram& histogram() const;
+
         void set_history_size(const size_t history);
 
 	private:
         bool m_Running = false;
 		StreamBuffer<Time> m_History;
+        TimeHistogram m_Histogram;
 		Time m_ElapsedTime, m_StartTime, m_Memory;
 	};
 
@@ -0,0 +1,129 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#include "TimeHistogram.hpp"
+
+#include <bit>
+#include <cmath>
+#include <algorithm>
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TimeHistogram::TimeHistogram()
+        : m_Buckets(SubBucketCount * (MaxMagnitudeBits - SubBucketBits + 1), 0)
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TimeHistogram::record(const Time& time)
+    {
+        const auto nanoseconds = static_cast<uint64_t>(std::max(time.nanoseconds(), 0.0));
+
+        m_Buckets[bucket_of(nanoseconds)]++;
+        m_Max = std::max(m_Max, nanoseconds);
+        m_Count++;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TimeHistogram::reset()
+    {
+        std::fill(m_Buckets.begin(), m_Buckets.end(), 0);
+        m_Count = 0;
+        m_Max = 0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Time TimeHistogram::percentile(const double percent) const
+    {
+        LVK_ASSERT_RANGE(percent, 0.0, 100.0);
+
+        if(m_Count == 0)
+            return Time(0);
+
+        // Find the first bucket at which the requested rank is reached.
+        const auto rank = std::max<uint64_t>(
+            static_cast<uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(m_Count))), 1
+        );
+
+        uint64_t total = 0;
+        for(size_t i = 0; i < m_Buckets.size(); i++)
+        {
+            total += m_Buckets[i];
+            if(total >= rank)
+                return Time(std::min(value_of(i), m_Max));
+        }
+
+        return Time(m_Max);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    Time TimeHistogram::max() const
+    {
+        return Time(m_Max);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t TimeHistogram::count() const
+    {
+        return m_Count;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t TimeHistogram::bucket_of(const uint64_t nanoseconds)
+    {
+        // The first SubBucketCount values are stored exactly.
+        if(nanoseconds < SubBucketCount)
+            return static_cast<size_t>(nanoseconds);
+
+        const uint32_t magnitude = std::bit_width(nanoseconds) - 1;
+        if(magnitude >= MaxMagnitudeBits)
+            return (MaxMagnitudeBits - SubBucketBits + 1) * SubBucketCount - 1;
+
+        // Keep the SubBucketBits bits below the leading bit as the linear sub-bucket.
+        const uint32_t shift = magnitude - SubBucketBits;
+        const uint64_t sub_bucket = (nanoseconds >> shift) - SubBucketCount;
+
+        return static_cast<size_t>((shift + 1) * SubBucketCount + sub_bucket);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t TimeHistogram::value_of(const size_t bucket)
+    {
+        if(bucket < SubBucketCount)
+            return bucket;
+
+        // Return the highest value which maps onto the bucket.
+        const uint64_t shift = bucket / SubBucketCount - 1;
+        const uint64_t sub_bucket = bucket % SubBucketCount;
+
+        return ((SubBucketCount + sub_bucket) << shift) + ((1ull << shift) - 1);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
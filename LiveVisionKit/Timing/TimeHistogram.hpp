@@ -0,0 +1,66 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "Time.hpp"
+
+namespace lvk
+{
+
+    // NOTE: a log-linear histogram in the style of HdrHistogram. Each power of
+    // two range is split into SubBucketCount linear buckets, so the recorded
+    // values are accurate to within 1/SubBucketCount of their magnitude.
+    class TimeHistogram
+    {
+    public:
+
+        static constexpr uint32_t SubBucketBits = 6;
+        static constexpr uint32_t SubBucketCount = 1u << SubBucketBits;
+
+        // Samples past ~18 minutes are clamped into the last bucket.
+        static constexpr uint32_t MaxMagnitudeBits = 40;
+
+
+        TimeHistogram();
+
+        void record(const Time& time);
+
+        void reset();
+
+
+        Time percentile(const double percent) const;
+
+        Time max() const;
+
+        uint64_t count() const;
+
+    private:
+
+        static size_t bucket_of(const uint64_t nanoseconds);
+
+        static uint64_t value_of(const size_t bucket);
+
+    private:
+        std::vector<uint32_t> m_Buckets;
+        uint64_t m_Count = 0, m_Max = 0;
+    };
+
+}
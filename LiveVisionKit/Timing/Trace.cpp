@@ -0,0 +1,270 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#include "Trace.hpp"
+
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <iomanip>
+#include <cstring>
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+    // Each thread can record up to 1M spans, after which new spans are dropped.
+    constexpr size_t TRACE_CHUNK_SPANS = 4096;
+    constexpr size_t TRACE_MAX_CHUNKS = 256;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    struct TraceSpan
+    {
+        char name[Trace::TraceNameLength];
+        const char* category;
+        int64_t start, end;
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    struct TraceChunk
+    {
+        std::array<TraceSpan, TRACE_CHUNK_SPANS> spans;
+        std::atomic<size_t> size = 0;
+        std::atomic<TraceChunk*> next = nullptr;
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: only the owning thread writes to the buffer. Readers walk the
+    // chunks through the atomic links and sizes, which are published last.
+    struct TraceBuffer
+    {
+        uint64_t thread_id = 0;
+        std::string thread_name;
+
+        std::atomic<TraceChunk*> head = nullptr;
+        TraceChunk* tail = nullptr;
+        size_t chunk_count = 0;
+        std::atomic<size_t> dropped = 0;
+
+        ~TraceBuffer()
+        {
+            TraceChunk* chunk = head.load();
+            while(chunk != nullptr)
+            {
+                TraceChunk* next = chunk->next.load();
+                delete chunk;
+                chunk = next;
+            }
+        }
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static std::atomic<bool> s_TraceEnabled = false;
+    static std::mutex s_TraceRegistryMutex;
+    static std::vector<std::shared_ptr<TraceBuffer>> s_TraceBuffers;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static TraceBuffer& local_trace_buffer()
+    {
+        // NOTE: the registry shares ownership of each buffer so
+        // that the spans of finished threads can still be written.
+        thread_local std::shared_ptr<TraceBuffer> buffer = [](){
+            auto new_buffer = std::make_shared<TraceBuffer>();
+
+            std::lock_guard<std::mutex> registry_lock(s_TraceRegistryMutex);
+            new_buffer->thread_id = s_TraceBuffers.size() + 1;
+            s_TraceBuffers.push_back(new_buffer);
+
+            return new_buffer;
+        }();
+
+        return *buffer;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void write_json_string(std::ostream& stream, const char* string)
+    {
+        stream << '\"';
+        for(const char* c = string; *c != '\0'; c++)
+        {
+            if(*c == '\"' || *c == '\\')
+                stream << '\\' << *c;
+            else if(static_cast<unsigned char>(*c) >= 0x20)
+                stream << *c;
+        }
+        stream << '\"';
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void Trace::enable(const bool enabled)
+    {
+        s_TraceEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool Trace::is_enabled()
+    {
+        return s_TraceEnabled.load(std::memory_order_relaxed);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void Trace::set_thread_name(const std::string& name)
+    {
+        auto& buffer = local_trace_buffer();
+
+        std::lock_guard<std::mutex> registry_lock(s_TraceRegistryMutex);
+        buffer.thread_name = name;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void Trace::record(const char* name, const char* category, const Time& start, const Time& end)
+    {
+        LVK_ASSERT(name != nullptr);
+        LVK_ASSERT(category != nullptr);
+
+        if(!is_enabled())
+            return;
+
+        auto& buffer = local_trace_buffer();
+
+        // Link a new chunk onto the buffer if the current one is full.
+        TraceChunk* chunk = buffer.tail;
+        if(chunk == nullptr || chunk->size.load(std::memory_order_relaxed) == TRACE_CHUNK_SPANS)
+        {
+            if(buffer.chunk_count >= TRACE_MAX_CHUNKS)
+            {
+                buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto* new_chunk = new TraceChunk();
+            if(chunk == nullptr)
+                buffer.head.store(new_chunk, std::memory_order_release);
+            else
+                chunk->next.store(new_chunk, std::memory_order_release);
+
+            buffer.tail = chunk = new_chunk;
+            buffer.chunk_count++;
+        }
+
+        const size_t index = chunk->size.load(std::memory_order_relaxed);
+        auto& span = chunk->spans[index];
+
+        std::strncpy(span.name, name, TraceNameLength - 1);
+        span.name[TraceNameLength - 1] = '\0';
+        span.category = category;
+        span.start = static_cast<int64_t>(start.nanoseconds());
+        span.end = static_cast<int64_t>(end.nanoseconds());
+
+        // Publish the span to any readers.
+        chunk->size.store(index + 1, std::memory_order_release);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void Trace::write(std::ostream& stream)
+    {
+        std::lock_guard<std::mutex> registry_lock(s_TraceRegistryMutex);
+
+        size_t dropped_spans = 0;
+        bool first_event = true;
+
+        stream << std::fixed << std::setprecision(3);
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for(const auto& buffer : s_TraceBuffers)
+        {
+            if(!buffer->thread_name.empty())
+            {
+                stream << (first_event ? "\n" : ",\n");
+                stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id
+                       << ",\"args\":{\"name\":";
+                write_json_string(stream, buffer->thread_name.c_str());
+                stream << "}}";
+                first_event = false;
+            }
+
+            // NOTE: timestamps and durations are given in microseconds.
+            TraceChunk* chunk = buffer->head.load(std::memory_order_acquire);
+            while(chunk != nullptr)
+            {
+                const size_t size = chunk->size.load(std::memory_order_acquire);
+                for(size_t i = 0; i < size; i++)
+                {
+                    const auto& span = chunk->spans[i];
+
+                    stream << (first_event ? "\n" : ",\n");
+                    stream << "{\"name\":";
+                    write_json_string(stream, span.name);
+                    stream << ",\"cat\":";
+                    write_json_string(stream, span.category);
+                    stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id
+                           << ",\"ts\":" << static_cast<double>(span.start) / 1000.0
+                           << ",\"dur\":" << static_cast<double>(span.end - span.start) / 1000.0
+                           << "}";
+                    first_event = false;
+                }
+                chunk = chunk->next.load(std::memory_order_acquire);
+            }
+
+            dropped_spans += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        stream << "\n],\"otherData\":{\"dropped_spans\":" << dropped_spans << "}}\n";
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TraceScope::TraceScope(const char* name, const char* category)
+        : m_Name(name),
+          m_Category(category),
+          m_Active(Trace::is_enabled())
+    {
+        if(m_Active) m_StartTime = Time::Now();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TraceScope::~TraceScope()
+    {
+        end();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TraceScope::end()
+    {
+        if(m_Active)
+        {
+            Trace::record(m_Name, m_Category, m_StartTime, Time::Now());
+            m_Active = false;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,80 @@
+//    Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// 	  **********************************************************************
+
+
+#pragma once
+
+#include <string>
+#include <ostream>
+
+#include "Time.hpp"
+
+namespace lvk
+{
+
+    // NOTE: spans are recorded into per-thread buffers without any locking,
+    // and are only gathered together when the trace is written out. Span
+    // names are copied on record and truncated to TraceNameLength chars.
+    class Trace
+    {
+    public:
+
+        static constexpr size_t TraceNameLength = 48;
+
+
+        static void enable(const bool enabled = true);
+
+        static bool is_enabled();
+
+
+        static void set_thread_name(const std::string& name);
+
+        static void record(const char* name, const char* category, const Time& start, const Time& end);
+
+
+        // Writes all recorded spans in the Chrome trace event JSON format.
+        static void write(std::ostream& stream);
+    };
+
+
+    class TraceScope
+    {
+    public:
+
+        explicit TraceScope(const char* name, const char* category = "lvk");
+
+        TraceScope(const TraceScope& other) = delete;
+
+        TraceScope& operator=(const TraceScope& other) = delete;
+
+        ~TraceScope();
+
+        void end();
+
+    private:
+        const char* m_Name;
+        const char* m_Category;
+        Time m_StartTime;
+        bool m_Active;
+    };
+
+}
+
+#define LVK_TRACE_CONCAT_INNER(a, b) a##b
+#define LVK_TRACE_CONCAT(a, b) LVK_TRACE_CONCAT_INNER(a, b)
+
+#define LVK_TRACE(name) lvk::TraceScope LVK_TRACE_CONCAT(_trace_, __LINE__)(name)
+#define LVK_TRACE_CATEGORY(name, category) lvk::TraceScope LVK_TRACE_CONCAT(_trace_, __LINE__)(name, category)
@@ -0,0 +1,244 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "MemoryTracker.hpp"
+
+#include <opencv2/core/utils/allocator_stats.hpp>
+#include <opencv2/core/ocl.hpp>
+#include <algorithm>
+#include <utility>
+#include <mutex>
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    thread_local std::shared_ptr<MemoryAccount> t_ActiveAccount = nullptr;
+
+    // NOTE: the tracker is never destroyed, as allocations may outlive static destruction.
+    MemoryTracker* s_InstalledTracker = nullptr;
+    std::once_flag s_InstallFlag;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryUsage MemoryAccount::usage() const
+    {
+        return {m_CurrentBytes.load(), m_PeakBytes.load()};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryAccount::reset_peak()
+    {
+        m_PeakBytes = m_CurrentBytes.load();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryAccount::add_allocation(const size_t bytes)
+    {
+        const size_t current_bytes = m_CurrentBytes += bytes;
+
+        size_t peak_bytes = m_PeakBytes.load();
+        while(current_bytes > peak_bytes && !m_PeakBytes.compare_exchange_weak(peak_bytes, current_bytes));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryAccount::remove_allocation(const size_t bytes)
+    {
+        LVK_ASSERT(m_CurrentBytes >= bytes);
+        m_CurrentBytes -= bytes;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryScope::MemoryScope(const std::shared_ptr<MemoryAccount>& account)
+        : m_PreviousAccount(std::exchange(t_ActiveAccount, account))
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryScope::~MemoryScope()
+    {
+        t_ActiveAccount = std::move(m_PreviousAccount);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryTracker::install()
+    {
+        std::call_once(s_InstallFlag, [](){
+            s_InstalledTracker = new MemoryTracker(cv::Mat::getDefaultAllocator());
+            cv::Mat::setDefaultAllocator(s_InstalledTracker);
+        });
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool MemoryTracker::is_installed()
+    {
+        return s_InstalledTracker != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryUsage MemoryTracker::device_usage()
+    {
+        const auto& statistics = cv::ocl::getOpenCLAllocatorStatistics();
+        return {
+            static_cast<size_t>(std::max<int64_t>(statistics.getCurrentUsage(), 0)),
+            static_cast<size_t>(std::max<int64_t>(statistics.getPeakUsage(), 0))
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    MemoryTracker::MemoryTracker(cv::MatAllocator* allocator)
+        : m_Allocator(allocator)
+    {
+        LVK_ASSERT(allocator != nullptr);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::UMatData* MemoryTracker::allocate(
+        int dims,
+        const int* sizes,
+        int type,
+        void* data,
+        size_t* step,
+        cv::AccessFlag flags,
+        cv::UMatUsageFlags usage_flags
+    ) const
+    {
+        cv::UMatData* u = m_Allocator->allocate(dims, sizes, type, data, step, flags, usage_flags);
+
+        // NOTE: user provided data is not owned by OpenCV, so is not accounted for. Tagged
+        // allocations are routed back through the tracker, to remove them on deallocation.
+        if(u != nullptr && data == nullptr && t_ActiveAccount != nullptr)
+        {
+            t_ActiveAccount->add_allocation(u->size);
+            u->allocatorContext = t_ActiveAccount;
+            u->currAllocator = this;
+        }
+        return u;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool MemoryTracker::allocate(cv::UMatData* data, cv::AccessFlag flags, cv::UMatUsageFlags usage_flags) const
+    {
+        return m_Allocator->allocate(data, flags, usage_flags);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryTracker::deallocate(cv::UMatData* data) const
+    {
+        if(data == nullptr)
+            return;
+
+        if(auto account = std::static_pointer_cast<MemoryAccount>(data->allocatorContext); account != nullptr)
+        {
+            account->remove_allocation(data->size);
+            data->allocatorContext.reset();
+        }
+
+        data->currAllocator = m_Allocator;
+        m_Allocator->deallocate(data);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryTracker::map(cv::UMatData* data, cv::AccessFlag flags) const
+    {
+        m_Allocator->map(data, flags);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryTracker::unmap(cv::UMatData* data) const
+    {
+        // NOTE: Mats are released by unmapping their last reference, which the wrapped
+        // allocator would deallocate directly, bypassing the tracker's accounting.
+        if(data->urefcount == 0 && data->refcount == 0)
+            deallocate(data);
+        else
+            m_Allocator->unmap(data);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryTracker::download(
+        cv::UMatData* data,
+        void* dst,
+        int dims,
+        const size_t sz[],
+        const size_t srcofs[],
+        const size_t srcstep[],
+        const size_t dststep[]
+    ) const
+    {
+        m_Allocator->download(data, dst, dims, sz, srcofs, srcstep, dststep);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryTracker::upload(
+        cv::UMatData* data,
+        const void* src,
+        int dims,
+        const size_t sz[],
+        const size_t dstofs[],
+        const size_t dststep[],
+        const size_t srcstep[]
+    ) const
+    {
+        m_Allocator->upload(data, src, dims, sz, dstofs, dststep, srcstep);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void MemoryTracker::copy(
+        cv::UMatData* srcdata,
+        cv::UMatData* dstdata,
+        int dims,
+        const size_t sz[],
+        const size_t srcofs[],
+        const size_t srcstep[],
+        const size_t dstofs[],
+        const size_t dststep[],
+        bool sync
+    ) const
+    {
+        m_Allocator->copy(srcdata, dstdata, dims, sz, srcofs, srcstep, dstofs, dststep, sync);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::BufferPoolController* MemoryTracker::getBufferPoolController(const char* id) const
+    {
+        return m_Allocator->getBufferPoolController(id);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
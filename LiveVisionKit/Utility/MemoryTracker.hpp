@@ -0,0 +1,151 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <memory>
+#include <atomic>
+
+namespace lvk
+{
+
+    struct MemoryUsage
+    {
+        size_t current_bytes = 0;
+        size_t peak_bytes = 0;
+    };
+
+
+    // Accumulates the memory allocated by OpenCV while the account is in scope. Memory stays
+    // on the account that allocated it for as long as it lives, even once it is handed on.
+    class MemoryAccount
+    {
+    public:
+
+        MemoryUsage usage() const;
+
+        void reset_peak();
+
+    private:
+        friend class MemoryTracker;
+
+        void add_allocation(const size_t bytes);
+
+        void remove_allocation(const size_t bytes);
+
+    private:
+        std::atomic<size_t> m_CurrentBytes = 0;
+        std::atomic<size_t> m_PeakBytes = 0;
+    };
+
+
+    // NOTE: makes the account active on the calling thread for the lifetime of the scope.
+    // Allocations made on other threads, such as in parallel loops, are not accounted for.
+    class MemoryScope
+    {
+    public:
+
+        explicit MemoryScope(const std::shared_ptr<MemoryAccount>& account);
+
+        ~MemoryScope();
+
+        MemoryScope(const MemoryScope&) = delete;
+
+        MemoryScope& operator=(const MemoryScope&) = delete;
+
+    private:
+        std::shared_ptr<MemoryAccount> m_PreviousAccount;
+    };
+
+
+    // Wraps OpenCV's default allocator to tag allocations with the active memory account.
+    class MemoryTracker final : public cv::MatAllocator
+    {
+    public:
+
+        // NOTE: only memory allocated after installation is tracked. Device memory of
+        // OpenCL UMats bypasses the default allocator, so is only tracked without OpenCL.
+        static void install();
+
+        static bool is_installed();
+
+        // NOTE: device memory of the OpenCL allocator is only known in total, across all accounts.
+        static MemoryUsage device_usage();
+
+
+        cv::UMatData* allocate(
+            int dims,
+            const int* sizes,
+            int type,
+            void* data,
+            size_t* step,
+            cv::AccessFlag flags,
+            cv::UMatUsageFlags usage_flags
+        ) const override;
+
+        bool allocate(cv::UMatData* data, cv::AccessFlag flags, cv::UMatUsageFlags usage_flags) const override;
+
+        void deallocate(cv::UMatData* data) const override;
+
+        void map(cv::UMatData* data, cv::AccessFlag flags) const override;
+
+        void unmap(cv::UMatData* data) const override;
+
+        void download(
+            cv::UMatData* data,
+            void* dst,
+            int dims,
+            const size_t sz[],
+            const size_t srcofs[],
+            const size_t srcstep[],
+            const size_t dststep[]
+        ) const override;
+
+        void upload(
+            cv::UMatData* data,
+            const void* src,
+            int dims,
+            const size_t sz[],
+            const size_t dstofs[],
+            const size_t dststep[],
+            const size_t srcstep[]
+        ) const override;
+
+        void copy(
+            cv::UMatData* srcdata,
+            cv::UMatData* dstdata,
+            int dims,
+            const size_t sz[],
+            const size_t srcofs[],
+            const size_t srcstep[],
+            const size_t dstofs[],
+            const size_t dststep[],
+            bool sync
+        ) const override;
+
+        cv::BufferPoolController* getBufferPoolController(const char* id = nullptr) const override;
+
+    private:
+
+        explicit MemoryTracker(cv::MatAllocator* allocator);
+
+    private:
+        cv::MatAllocator* const m_Allocator;
+    };
+
+}
@@ -0,0 +1,102 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "TaskGraph.hpp"
+
+#include "Directives.hpp"
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TaskGraph::TaskID TaskGraph::add_task(TaskPool::Task&& task)
+    {
+        LVK_ASSERT(task != nullptr);
+
+        auto& node = m_Nodes.emplace_back(std::make_unique<Node>());
+        node->task = std::move(task);
+
+        return m_Nodes.size() - 1;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskGraph::add_dependency(const TaskID before, const TaskID after)
+    {
+        LVK_ASSERT(before < m_Nodes.size());
+        LVK_ASSERT(after < m_Nodes.size());
+        LVK_ASSERT(before != after);
+
+        m_Nodes[before]->dependents.push_back(after);
+        m_Nodes[after]->dependencies++;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskGraph::run(TaskPool& pool)
+    {
+        for(auto& node : m_Nodes)
+            node->remaining_dependencies = node->dependencies;
+
+        TaskGroup group(pool);
+        std::atomic<size_t> tasks_run = 0;
+
+        // NOTE: dependents are launched from within the group, so it
+        // always has pending tasks until the whole graph has finished.
+        std::function<void(TaskID)> launch = [&](const TaskID id){
+            group.run([&, id](){
+                auto& node = *m_Nodes[id];
+                node.task();
+                tasks_run++;
+
+                for(const TaskID dependent : node.dependents)
+                {
+                    if(--m_Nodes[dependent]->remaining_dependencies == 0)
+                        launch(dependent);
+                }
+            });
+        };
+
+        for(TaskID id = 0; id < m_Nodes.size(); id++)
+        {
+            if(m_Nodes[id]->dependencies == 0)
+                launch(id);
+        }
+        group.wait();
+
+        // NOTE: tasks on a dependency cycle can never be launched.
+        LVK_ASSERT(tasks_run == m_Nodes.size());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t TaskGraph::size() const
+    {
+        return m_Nodes.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskGraph::clear()
+    {
+        m_Nodes.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
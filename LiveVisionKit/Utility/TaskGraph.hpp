@@ -0,0 +1,63 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <vector>
+
+#include "TaskPool.hpp"
+
+namespace lvk
+{
+
+    // NOTE: tasks are submitted to the pool as soon as all their
+    // dependencies have finished, so independent branches run in parallel.
+    class TaskGraph
+    {
+    public:
+
+        using TaskID = size_t;
+
+
+        TaskID add_task(TaskPool::Task&& task);
+
+        void add_dependency(const TaskID before, const TaskID after);
+
+        // NOTE: blocks until every task has run, helping the pool in the meantime.
+        void run(TaskPool& pool = TaskPool::global());
+
+        size_t size() const;
+
+        void clear();
+
+    private:
+
+        struct Node
+        {
+            TaskPool::Task task;
+            std::vector<TaskID> dependents;
+            size_t dependencies = 0;
+            std::atomic<size_t> remaining_dependencies = 0;
+        };
+
+    private:
+        std::vector<std::unique_ptr<Node>> m_Nodes;
+    };
+
+}
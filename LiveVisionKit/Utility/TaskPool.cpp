@@ -0,0 +1,527 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "TaskPool.hpp"
+
+#include <opencv2/core/parallel/parallel_backend.hpp>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "Directives.hpp"
+#include "Timing/Trace.hpp"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace lvk
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr int CHUNKS_PER_THREAD = 4;
+    constexpr auto HELP_POLL_PERIOD = std::chrono::microseconds(100);
+
+    thread_local const TaskPool* t_WorkerPool = nullptr;
+    thread_local size_t t_WorkerIndex = 0;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    class TaskPoolBackend final : public cv::parallel::ParallelForAPI
+    {
+    public:
+
+        explicit TaskPoolBackend(TaskPool& pool)
+            : m_Pool(pool)
+        {}
+
+        void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) override
+        {
+            m_Pool.parallel_for(cv::Range(0, tasks), [&](const cv::Range& range){
+                body_callback(range.start, range.end, callback_data);
+            });
+        }
+
+        int getThreadNum() const override
+        {
+            // NOTE: any thread outside of the pool is seen as the main thread.
+            const auto index = m_Pool.worker_index();
+            return index.has_value() ? static_cast<int>(*index) + 1 : 0;
+        }
+
+        int getNumThreads() const override
+        {
+            return static_cast<int>(m_Pool.worker_count()) + 1;
+        }
+
+        int setNumThreads(int threads) override
+        {
+            // NOTE: OpenCV counts the calling thread, which always helps to run the tasks.
+            const int previous_threads = getNumThreads();
+            m_Pool.set_worker_count(threads < 0 ? TaskPool::default_worker_count() : std::max(threads - 1, 0));
+            return previous_threads;
+        }
+
+        const char* getName() const override
+        {
+            return "lvk";
+        }
+
+    private:
+        TaskPool& m_Pool;
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TaskPool& TaskPool::global()
+    {
+        static TaskPool pool;
+        return pool;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::route_opencv(const bool enabled)
+    {
+        cv::parallel::setParallelForBackend(
+            enabled ? std::make_shared<TaskPoolBackend>(global()) : std::shared_ptr<cv::parallel::ParallelForAPI>(),
+            false
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t TaskPool::default_worker_count()
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TaskPool::TaskPool(const size_t workers)
+    {
+        start_workers(workers);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TaskPool::~TaskPool()
+    {
+        stop_workers();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::submit(Task&& task)
+    {
+        submit(std::move(task), nullptr);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::submit(Task&& task, const TaskGroup* group)
+    {
+        LVK_ASSERT(task != nullptr);
+
+        m_QueuedTasks++;
+
+        // Workers keep their own tasks local, so that they are run while still hot in cache.
+        if(const auto index = worker_index(); index.has_value())
+        {
+            std::shared_lock workers_lock(m_WorkersMutex);
+            auto& worker = *m_Workers[*index];
+
+            std::scoped_lock lock(worker.mutex);
+            worker.tasks.push_back({std::move(task), group});
+        }
+        else
+        {
+            std::scoped_lock lock(m_SharedMutex);
+            m_SharedTasks.push_back({std::move(task), group});
+        }
+
+        // NOTE: the sleep lock is taken so a worker cannot miss the wake up
+        // between checking for queued tasks and going to sleep on the flag.
+        {
+            std::scoped_lock lock(m_SleepMutex);
+        }
+        m_TaskAvailable.notify_one();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool TaskPool::try_run_task()
+    {
+        Task task;
+        if(!try_pop(task, worker_index()))
+            return false;
+
+        task();
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool TaskPool::try_run_task(const TaskGroup& group)
+    {
+        Task task;
+        if(!try_pop(task, worker_index(), &group))
+            return false;
+
+        task();
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool TaskPool::try_pop(Task& task, const std::optional<size_t>& worker, const TaskGroup* group)
+    {
+        std::shared_lock workers_lock(m_WorkersMutex);
+        const size_t worker_count = m_Workers.size();
+
+        const auto is_wanted = [group](const QueuedTask& queued){
+            return group == nullptr || queued.group == group;
+        };
+
+        const auto take = [&](std::deque<QueuedTask>& tasks, const bool newest){
+            auto iter = tasks.end();
+            if(newest)
+            {
+                const auto newest_iter = std::find_if(tasks.rbegin(), tasks.rend(), is_wanted);
+                if(newest_iter != tasks.rend())
+                    iter = std::prev(newest_iter.base());
+            }
+            else iter = std::find_if(tasks.begin(), tasks.end(), is_wanted);
+
+            if(iter == tasks.end())
+                return false;
+
+            task = std::move(iter->task);
+            tasks.erase(iter);
+            m_QueuedTasks--;
+            return true;
+        };
+
+        // Run our own newest task first, then any shared tasks.
+        if(worker.has_value() && *worker < worker_count)
+        {
+            auto& own = *m_Workers[*worker];
+            std::scoped_lock lock(own.mutex);
+            if(take(own.tasks, true))
+                return true;
+        }
+
+        {
+            std::scoped_lock lock(m_SharedMutex);
+            if(take(m_SharedTasks, false))
+                return true;
+        }
+
+        // Otherwise steal the oldest task of another worker, starting
+        // from the next worker along to spread out the thieves.
+        const size_t start = worker.value_or(worker_count - 1) + 1;
+        for(size_t i = 0; i < worker_count; i++)
+        {
+            auto& victim = *m_Workers[(start + i) % worker_count];
+            std::scoped_lock lock(victim.mutex);
+            if(take(victim.tasks, false))
+                return true;
+        }
+
+        return false;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::parallel_for(
+        const cv::Range& range,
+        const std::function<void(const cv::Range&)>& body,
+        const int grain
+    )
+    {
+        LVK_ASSERT(grain >= 1);
+
+        const int length = range.size();
+        if(length <= 0)
+            return;
+
+        // Over-split the range to balance out uneven chunks through stealing.
+        const int threads = static_cast<int>(worker_count()) + 1;
+        const int chunk_count = std::min((length + grain - 1) / grain, threads * CHUNKS_PER_THREAD);
+        if(threads == 1 || chunk_count <= 1)
+        {
+            body(range);
+            return;
+        }
+
+        const int chunk_size = length / chunk_count, remainder = length % chunk_count;
+        const auto chunk = [&](const int index){
+            const int start = range.start + index * chunk_size + std::min(index, remainder);
+            return cv::Range(start, start + chunk_size + (index < remainder ? 1 : 0));
+        };
+
+        TaskGroup group(*this);
+        for(int i = 1; i < chunk_count; i++)
+        {
+            group.run([&body, chunk_range = chunk(i)](){
+                body(chunk_range);
+            });
+        }
+
+        body(chunk(0));
+        group.wait();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::set_worker_count(const size_t workers)
+    {
+        // NOTE: a worker would have to wait on itself to stop.
+        LVK_ASSERT(!worker_index().has_value());
+
+        std::scoped_lock lock(m_ResizeMutex);
+        if(workers == worker_count())
+            return;
+
+        stop_workers();
+        start_workers(workers);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t TaskPool::worker_count() const
+    {
+        std::shared_lock lock(m_WorkersMutex);
+        return m_Workers.size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::set_affinity(const bool pinned)
+    {
+        std::scoped_lock lock(m_ResizeMutex);
+        m_Pinned = pinned;
+
+        std::shared_lock workers_lock(m_WorkersMutex);
+        for(size_t i = 0; i < m_Workers.size(); i++)
+            pin_worker(*m_Workers[i], i);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool TaskPool::is_pinned() const
+    {
+        return m_Pinned;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<size_t> TaskPool::worker_index() const
+    {
+        if(t_WorkerPool == this)
+            return t_WorkerIndex;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::start_workers(const size_t workers)
+    {
+        std::unique_lock lock(m_WorkersMutex);
+        m_Stopping = false;
+
+        // NOTE: all workers must exist before any start, as they steal from each other.
+        for(size_t i = 0; i < workers; i++)
+            m_Workers.emplace_back(std::make_unique<Worker>());
+
+        for(size_t i = 0; i < workers; i++)
+        {
+            m_Workers[i]->thread = std::thread(&TaskPool::run_worker, this, i);
+            pin_worker(*m_Workers[i], i);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::stop_workers()
+    {
+        {
+            std::scoped_lock lock(m_SleepMutex);
+            m_Stopping = true;
+        }
+        m_TaskAvailable.notify_all();
+
+        // NOTE: the workers are joined without the workers lock, as they may be stealing.
+        for(auto& worker : m_Workers)
+            worker->thread.join();
+
+        std::unique_lock lock(m_WorkersMutex);
+
+        // Hand any tasks left behind over to the shared queue, so none are lost.
+        std::scoped_lock shared_lock(m_SharedMutex);
+        for(auto& worker : m_Workers)
+        {
+            for(auto& task : worker->tasks)
+                m_SharedTasks.push_back(std::move(task));
+        }
+        m_Workers.clear();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::run_worker(const size_t index)
+    {
+        t_WorkerPool = this;
+        t_WorkerIndex = index;
+        Trace::set_thread_name(cv::format("Task Worker %zu", index));
+
+        Task task;
+        while(!m_Stopping)
+        {
+            if(try_pop(task, index))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock lock(m_SleepMutex);
+            m_TaskAvailable.wait(lock, [this](){
+                return m_QueuedTasks > 0 || m_Stopping;
+            });
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskPool::pin_worker(Worker& worker, const size_t index) const
+    {
+        // NOTE: the first core is left to the calling thread, which also runs tasks.
+        const size_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+        const size_t core = (index + 1) % cores;
+
+#ifdef _WIN32
+        DWORD_PTR process_mask = 0, system_mask = 0;
+        GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask);
+
+        const DWORD_PTR core_mask = static_cast<DWORD_PTR>(1) << (core % (8 * sizeof(DWORD_PTR)));
+        SetThreadAffinityMask(worker.thread.native_handle(), m_Pinned ? core_mask : process_mask);
+#elif defined(__linux__)
+        cpu_set_t core_set;
+        CPU_ZERO(&core_set);
+        if(m_Pinned)
+            CPU_SET(core, &core_set);
+        else for(size_t c = 0; c < cores; c++)
+            CPU_SET(c, &core_set);
+
+        pthread_setaffinity_np(worker.thread.native_handle(), sizeof(cpu_set_t), &core_set);
+#endif
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TaskGroup::TaskGroup(TaskPool& pool)
+        : m_Pool(pool)
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TaskGroup::~TaskGroup()
+    {
+        // NOTE: destructors must not throw, so any exception is dropped.
+        wait_for_tasks();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskGroup::run(TaskPool::Task&& task)
+    {
+        m_PendingTasks++;
+        m_Pool.submit([this, task = std::move(task)](){
+            std::exception_ptr exception = nullptr;
+            try
+            {
+                task();
+            }
+            catch(...)
+            {
+                exception = std::current_exception();
+            }
+
+            // NOTE: the count is decremented under the lock, so that the
+            // group cannot be destroyed by a waiter until we release it.
+            std::scoped_lock lock(m_Mutex);
+            if(exception != nullptr && m_Exception == nullptr)
+                m_Exception = exception;
+
+            if(--m_PendingTasks == 0)
+                m_TasksFinished.notify_all();
+        }, this);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskGroup::wait()
+    {
+        wait_for_tasks();
+
+        // Pass the first exception of the tasks on to the waiter, like OpenCV's parallel loops.
+        std::unique_lock lock(m_Mutex);
+        if(auto exception = std::exchange(m_Exception, nullptr); exception != nullptr)
+        {
+            lock.unlock();
+            std::rethrow_exception(exception);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void TaskGroup::wait_for_tasks()
+    {
+        while(true)
+        {
+            // Help to run our own tasks while waiting. Other tasks are left alone, as they
+            // may wait on work of their own, nesting arbitrarily deep on our stack.
+            if(m_PendingTasks > 0 && m_Pool.try_run_task(*this))
+                continue;
+
+            // NOTE: the wait times out in case new tasks were queued that we could help with.
+            std::unique_lock lock(m_Mutex);
+            if(m_PendingTasks == 0)
+                return;
+
+            m_TasksFinished.wait_for(lock, HELP_POLL_PERIOD);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void parallel_for(const cv::Range& range, const std::function<void(const cv::Range&)>& body, const int grain)
+    {
+        TaskPool::global().parallel_for(range, body, grain);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,170 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <condition_variable>
+#include <opencv2/core.hpp>
+#include <shared_mutex>
+#include <functional>
+#include <optional>
+#include <exception>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <deque>
+#include <mutex>
+
+namespace lvk
+{
+
+    class TaskGroup;
+
+    // NOTE: each worker owns a deque of tasks, which it runs newest first,
+    // while idle workers steal the oldest tasks of the others. Any thread
+    // waiting on a TaskGroup helps to run the tasks of that group, so parallel
+    // regions may be nested without deadlocking or oversubscribing the cores.
+    // Waiters never run unrelated tasks, which could nest arbitrarily deep on
+    // their stack. Tasks submitted directly must not throw, instead use a
+    // TaskGroup to pass exceptions back to the waiter.
+    class TaskPool
+    {
+    public:
+
+        using Task = std::function<void()>;
+
+        static TaskPool& global();
+
+        // Routes OpenCV's parallel loops and setNumThreads through the global pool.
+        // NOTE: disabling restores OpenCV's own built-in parallel backend.
+        static void route_opencv(const bool enabled = true);
+
+
+        explicit TaskPool(const size_t workers = default_worker_count());
+
+        ~TaskPool();
+
+        TaskPool(const TaskPool&) = delete;
+
+        TaskPool& operator=(const TaskPool&) = delete;
+
+
+        void submit(Task&& task);
+
+        // Runs one pending task on the calling thread, if there is any.
+        bool try_run_task();
+
+        void parallel_for(const cv::Range& range, const std::function<void(const cv::Range&)>& body, const int grain = 1);
+
+
+        // NOTE: the calling thread also runs tasks while waiting,
+        // so the pool is usually given one less worker than cores.
+        void set_worker_count(const size_t workers);
+
+        size_t worker_count() const;
+
+        // NOTE: pins each worker to its own core, in order.
+        void set_affinity(const bool pinned);
+
+        bool is_pinned() const;
+
+        // NOTE: only has a value when called from one of this pool's workers.
+        std::optional<size_t> worker_index() const;
+
+        static size_t default_worker_count();
+
+    private:
+        friend class TaskGroup;
+
+        struct QueuedTask
+        {
+            Task task;
+            const TaskGroup* group = nullptr;
+        };
+
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<QueuedTask> tasks;
+            std::thread thread;
+        };
+
+        void submit(Task&& task, const TaskGroup* group);
+
+        // Runs one pending task of the group on the calling thread, if there is any.
+        bool try_run_task(const TaskGroup& group);
+
+        void start_workers(const size_t workers);
+
+        void stop_workers();
+
+        void run_worker(const size_t index);
+
+        // NOTE: if a group is given, only the tasks of that group are taken.
+        bool try_pop(Task& task, const std::optional<size_t>& worker, const TaskGroup* group = nullptr);
+
+        void pin_worker(Worker& worker, const size_t index) const;
+
+    private:
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        mutable std::shared_mutex m_WorkersMutex;
+        std::mutex m_ResizeMutex;
+
+        std::mutex m_SharedMutex;
+        std::deque<QueuedTask> m_SharedTasks;
+
+        std::mutex m_SleepMutex;
+        std::condition_variable m_TaskAvailable;
+        std::atomic<size_t> m_QueuedTasks = 0;
+        std::atomic<bool> m_Stopping = false;
+        bool m_Pinned = false;
+    };
+
+
+    // A set of tasks which can be waited on together, from any thread.
+    // NOTE: the first exception thrown by a task is rethrown by wait().
+    class TaskGroup
+    {
+    public:
+
+        explicit TaskGroup(TaskPool& pool = TaskPool::global());
+
+        ~TaskGroup();
+
+        void run(TaskPool::Task&& task);
+
+        void wait();
+
+    private:
+
+        void wait_for_tasks();
+
+    private:
+        TaskPool& m_Pool;
+        std::atomic<size_t> m_PendingTasks = 0;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_TasksFinished;
+        std::exception_ptr m_Exception = nullptr;
+    };
+
+
+    // NOTE: splits the range across the global task pool, and runs the first part on the calling thread.
+    void parallel_for(const cv::Range& range, const std::function<void(const cv::Range&)>& body, const int grain = 1);
+
+}
@@ -21,6 +21,7 @@
 #include "Math/Homography.hpp"
 #include "Functions/Container.hpp"
 #include "Functions/Extensions.hpp"
+#include "Timing/Trace.hpp"
 
 namespace lvk
 {
@@ -86,7 +87,7 @@ namespace lvk
         {
             m_MatchedPoints.clear();
             m_FeatureDetector.reset();
-            cv::resize(m_CurrentFrame, m_CurrentFrame, m_Settings.detection_resolution, 0, 0, cv::INTER_LINEAR);
+            cv::resize(m_CurrentFrame, m_CurrentFrame, settings.detection_resolution, 0, 0, cv::INTER_LINEAR);
         }
 
         m_Settings = settings;
@@ -113,8 +114,10 @@ namespace lvk
         m_TrackingStability = 0.0f;
 
         // Advance time and import the next frame.
+        TraceScope resize_trace("Resize", "tracker");
         std::swap(m_PreviousFrame, m_CurrentFrame);
         cv::resize(next_frame, m_CurrentFrame, m_Settings.detection_resolution, 0, 0, cv::INTER_AREA);
+        resize_trace.end();
 
         // We need at least two frames for tracking.
         if(!m_FrameInitialized || m_CurrentFrame.size() != m_PreviousFrame.size())
@@ -124,7 +127,9 @@ namespace lvk
         }
 
         // Detect features in the current frame.
+        TraceScope detect_trace("Detect", "tracker");
         const auto distribution = m_FeatureDetector.detect(m_CurrentFrame, m_TrackedFeatures);
+        detect_trace.end();
         if(m_TrackedFeatures.size() < m_Settings.min_motion_samples || distribution < m_Settings.uniformity_threshold)
         {
             m_TrackedFeatures.clear();
@@ -137,6 +142,7 @@ namespace lvk
             m_TrackedPoints.emplace_back(feature.pt);
 
 		// Match tracking points.
+        TraceScope match_trace("Optical Flow", "tracker");
         m_OpticalTracker->calc(
             m_PreviousFrame,
             m_CurrentFrame,
@@ -144,6 +150,7 @@ namespace lvk
             m_MatchedPoints,
             m_MatchStatus
         );
+        match_trace.end();
 
         // Filter out unmatched points
         fast_filter(m_TrackedFeatures, m_TrackedPoints, m_MatchedPoints, m_MatchStatus);
@@ -154,6 +161,7 @@ namespace lvk
         }
 
         // Estimate motion using the tracking results
+        TraceScope solve_trace("Solve", "tracker");
         WarpMesh motion(m_Settings.motion_resolution);
         if(m_Settings.track_local_motions)
         {
@@ -175,6 +183,8 @@ namespace lvk
             );
         }
 
+        solve_trace.end();
+
         // Measure tracking stability as the inlier ratio
         m_TrackingStability = ratio_of<uint8_t>(m_InlierStatus, 1);
 
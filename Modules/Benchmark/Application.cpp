@@ -0,0 +1,40 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <benchmark/benchmark.h>
+#include <LiveVisionKit.hpp>
+
+// NOTE: results can be saved for comparison across commits using
+// --benchmark_out=<file>.json --benchmark_out_format=json
+
+int main(int argc, char* argv[])
+{
+    // Fail loudly on any LVK assert, as the results would be meaningless.
+    lvk::context::assert_handler = [](auto, auto, const std::string& assertion){
+        std::cerr << cv::format("LiveVisionKit failed condition: %s\n", assertion.c_str());
+        std::abort();
+    };
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <LiveVisionKit.hpp>
+
+#include "SyntheticVideo.hpp"
+
+namespace bench
+{
+
+    // Resolutions are given by their height, with a 16:9 aspect ratio.
+    inline cv::Size resolution_of(const int64_t height)
+    {
+        return {static_cast<int>(height * 16 / 9), static_cast<int>(height)};
+    }
+
+    // Standard parameters of frame resolution and OpenCV thread count.
+    inline void resolution_and_threads(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->ArgNames({"height", "threads"})
+                 ->ArgsProduct({{720, 1080, 2160}, {1, 4, 8}})
+                 ->Unit(benchmark::kMillisecond)
+                 ->UseRealTime();
+    }
+
+    // Sets the OpenCV thread count for the lifetime of the scope.
+    class ThreadScope
+    {
+    public:
+
+        explicit ThreadScope(const int threads)
+            : m_PreviousThreads(cv::getNumThreads())
+        {
+            cv::setNumThreads(threads);
+        }
+
+        ~ThreadScope()
+        {
+            cv::setNumThreads(m_PreviousThreads);
+        }
+
+    private:
+        int m_PreviousThreads;
+    };
+
+    // NOTE: OpenCL work is asynchronous, so the queue must be
+    // finished within each iteration for its time to be counted.
+    inline void sync_gpu()
+    {
+        cv::ocl::finish();
+    }
+
+}
@@ -0,0 +1,73 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr const char* FORMAT_NAMES[] = {"BGR", "BGRA", "RGB", "RGBA", "YUV", "GRAY"};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_VideoFrame_ReformatTo(benchmark::State& state)
+    {
+        const auto src_format = static_cast<lvk::VideoFrame::Format>(state.range(0));
+        const auto dst_format = static_cast<lvk::VideoFrame::Format>(state.range(1));
+        state.SetLabel(
+            std::string(FORMAT_NAMES[src_format]) + " -> " + FORMAT_NAMES[dst_format]
+                + (state.range(4) != 0 ? " (OpenCL)" : " (CPU)")
+        );
+
+        const ThreadScope threads(static_cast<int>(state.range(3)));
+        SyntheticVideo video(resolution_of(state.range(2)));
+
+        lvk::VideoFrame input, output;
+        video.next(input, src_format);
+        sync_gpu();
+
+        // Compare the OpenCL kernels against the SIMD CPU conversions.
+        const bool used_opencl = cv::ocl::useOpenCL();
+        const bool use_opencl = state.range(4) != 0;
+        cv::ocl::setUseOpenCL(use_opencl);
+
+        for(auto _ : state)
+        {
+            input.reformatTo(output, dst_format);
+            sync_gpu();
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        cv::ocl::setUseOpenCL(used_opencl);
+    }
+
+    // Covers every conversion between two different known formats, on both paths.
+    BENCHMARK(BM_VideoFrame_ReformatTo)->Apply([](benchmark::internal::Benchmark* benchmark){
+        benchmark->ArgNames({"src", "dst", "height", "threads", "opencl"});
+        for(int64_t src = lvk::VideoFrame::BGR; src < lvk::VideoFrame::UNKNOWN; src++)
+            for(int64_t dst = lvk::VideoFrame::BGR; dst < lvk::VideoFrame::UNKNOWN; dst++)
+                for(const int64_t height : {720, 1080, 2160})
+                    for(const int64_t threads : {1, 4, 8})
+                        for(const int64_t opencl : {0, 1})
+                            if(src != dst) benchmark->Args({src, dst, height, threads, opencl});
+
+        benchmark->Unit(benchmark::kMicrosecond)->UseRealTime();
+    });
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,136 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Applies the filter to a synthetic video, excluding the frame generation time.
+    static void run_filter(
+        benchmark::State& state,
+        lvk::VideoFilter& filter,
+        const lvk::VideoFrame::Format format = lvk::VideoFrame::YUV
+    )
+    {
+        const ThreadScope threads(static_cast<int>(state.range(1)));
+        SyntheticVideo video(resolution_of(state.range(0)));
+
+        lvk::VideoFrame input, output;
+        for(auto _ : state)
+        {
+            state.PauseTiming();
+            video.next(input, format);
+            sync_gpu();
+            state.ResumeTiming();
+
+            filter.apply(std::move(input), output);
+            sync_gpu();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_StabilizationFilter(benchmark::State& state)
+    {
+        lvk::StabilizationFilter filter;
+        run_filter(state, filter);
+    }
+    BENCHMARK(BM_StabilizationFilter)->Apply(resolution_and_threads);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_DeblockingFilter(benchmark::State& state)
+    {
+        lvk::DeblockingFilter filter;
+        run_filter(state, filter);
+    }
+    BENCHMARK(BM_DeblockingFilter)->Apply(resolution_and_threads);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_ScalingFilter(benchmark::State& state)
+    {
+        // Upscale by 1.5x, as is typical of 720p to 1080p.
+        lvk::ScalingFilter filter(resolution_of(state.range(0) * 3 / 2));
+        run_filter(state, filter);
+    }
+    BENCHMARK(BM_ScalingFilter)->Apply(resolution_and_threads);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_ConversionFilter(benchmark::State& state)
+    {
+        lvk::ConversionFilter filter(cv::COLOR_BGR2YUV);
+        run_filter(state, filter, lvk::VideoFrame::BGR);
+    }
+    BENCHMARK(BM_ConversionFilter)->Apply(resolution_and_threads);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Stabilizes many 720p streams at once on a fixed pool of worker threads.
+    static void BM_StreamScheduler(benchmark::State& state)
+    {
+        constexpr size_t stream_frames = 60;
+
+        const auto stream_count = static_cast<size_t>(state.range(0));
+        const auto worker_count = static_cast<size_t>(state.range(1));
+        const ThreadScope threads(1);
+
+        // Pre-generate the frames, so that only the scheduled streams are measured.
+        SyntheticVideo video(resolution_of(720));
+        std::vector<lvk::VideoFrame> frames(stream_frames);
+        for(auto& frame : frames)
+            video.next(frame);
+
+        lvk::TaskPool pool(worker_count);
+        for(auto _ : state)
+        {
+            state.PauseTiming();
+            lvk::StreamScheduler scheduler(pool);
+            for(size_t s = 0; s < stream_count; s++)
+            {
+                scheduler.add_stream(
+                    [&, next = size_t(0)](lvk::Frame& frame) mutable {
+                        if(next >= frames.size())
+                            return false;
+
+                        frames[next++].copyTo(frame);
+                        return true;
+                    },
+                    std::make_shared<lvk::StabilizationFilter>(),
+                    [](lvk::Frame&){ return false; }
+                );
+            }
+            sync_gpu();
+            state.ResumeTiming();
+
+            scheduler.run();
+            sync_gpu();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * stream_count * stream_frames));
+    }
+    BENCHMARK(BM_StreamScheduler)
+        ->ArgNames({"streams", "workers"})
+        ->ArgsProduct({{1, 4, 8}, {2, 4, 8}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,157 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmark.hpp"
+
+#include <functional>
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_WarpMesh_Apply(benchmark::State& state)
+    {
+        const ThreadScope threads(static_cast<int>(state.range(1)));
+        SyntheticVideo video(resolution_of(state.range(0)));
+
+        // A mild rotation so that the mesh is not a pure translation.
+        const cv::Point2f centre(0.5f, 0.5f);
+        lvk::WarpMesh mesh(cv::Size(16, 16));
+        mesh.set_to(
+            lvk::Homography::FromAffineMatrix(cv::getRotationMatrix2D(centre, 1.0, 1.0)),
+            cv::Size2f(1.0f, 1.0f)
+        );
+
+        lvk::VideoFrame input, output;
+        video.next(input);
+
+        for(auto _ : state)
+        {
+            mesh.apply(input, output);
+            sync_gpu();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_WarpMesh_Apply)->Apply(resolution_and_threads);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_WarpMesh_Read(benchmark::State& state)
+    {
+        const cv::Size mesh_size(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+        lvk::WarpMesh mesh(mesh_size);
+
+        for(auto _ : state)
+        {
+            float total = 0.0f;
+            mesh.read([&](const cv::Point2f& offset, const cv::Point& coord){
+                total += offset.x + offset.y;
+            }, false);
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * mesh_size.area());
+    }
+    BENCHMARK(BM_WarpMesh_Read)->ArgName("mesh")->RangeMultiplier(2)->Range(2, 64);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Baseline of BM_WarpMesh_Read, calling the operation through a std::function as before it was templated.
+    static void BM_WarpMesh_Read_Function(benchmark::State& state)
+    {
+        const cv::Size mesh_size(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+        lvk::WarpMesh mesh(mesh_size);
+
+        float total = 0.0f;
+        const std::function<void(const cv::Point2f&, const cv::Point&)> operation =
+            [&](const cv::Point2f& offset, const cv::Point& coord){
+                total += offset.x + offset.y;
+            };
+
+        for(auto _ : state)
+        {
+            total = 0.0f;
+            mesh.read(operation, false);
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * mesh_size.area());
+    }
+    BENCHMARK(BM_WarpMesh_Read_Function)->ArgName("mesh")->RangeMultiplier(2)->Range(2, 64);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_WarpMesh_Write(benchmark::State& state)
+    {
+        const cv::Size mesh_size(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+        lvk::WarpMesh mesh(mesh_size);
+
+        for(auto _ : state)
+        {
+            mesh.write([&](cv::Point2f& offset, const cv::Point& coord){
+                offset.x = static_cast<float>(coord.x) * 0.01f;
+                offset.y = static_cast<float>(coord.y) * 0.01f;
+            });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * mesh_size.area());
+    }
+    BENCHMARK(BM_WarpMesh_Write)->ArgName("mesh")->RangeMultiplier(2)->Range(2, 64);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Baseline of BM_WarpMesh_Write, calling the operation through a std::function as before it was templated.
+    static void BM_WarpMesh_Write_Function(benchmark::State& state)
+    {
+        const cv::Size mesh_size(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+        lvk::WarpMesh mesh(mesh_size);
+
+        const std::function<void(cv::Point2f&, const cv::Point&)> operation =
+            [](cv::Point2f& offset, const cv::Point& coord){
+                offset.x = static_cast<float>(coord.x) * 0.01f;
+                offset.y = static_cast<float>(coord.y) * 0.01f;
+            };
+
+        for(auto _ : state)
+        {
+            mesh.write(operation);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * mesh_size.area());
+    }
+    BENCHMARK(BM_WarpMesh_Write_Function)->ArgName("mesh")->RangeMultiplier(2)->Range(2, 64);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_Homography_Transform(benchmark::State& state)
+    {
+        const auto homography = lvk::Homography::FromAffineMatrix(cv::getRotationMatrix2D({100, 100}, 5.0, 1.1));
+
+        cv::RNG rng(1);
+        std::vector<cv::Point2f> points(static_cast<size_t>(state.range(0))), transformed_points;
+        for(auto& point : points)
+            point = cv::Point2f(rng.uniform(0.0f, 1920.0f), rng.uniform(0.0f, 1080.0f));
+
+        for(auto _ : state)
+        {
+            homography.transform(points, transformed_points);
+            benchmark::DoNotOptimize(transformed_points.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Homography_Transform)->ArgName("points")->RangeMultiplier(8)->Range(4, 4096);
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,128 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "SyntheticVideo.hpp"
+
+#include <numbers>
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Proportion of the resolution which the plane may move across.
+    constexpr float MOTION_AMPLITUDE = 0.05f;
+
+    // Number of randomly placed shapes, per megapixel, used to create trackable corners.
+    constexpr int TEXTURE_SHAPE_DENSITY = 2000;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    SyntheticVideo::SyntheticVideo(const cv::Size& resolution, const uint32_t period, const uint64_t seed)
+        : m_Resolution(resolution),
+          m_Period(period)
+    {
+        LVK_ASSERT(resolution.width > 0 && resolution.height > 0);
+        LVK_ASSERT(period > 0);
+
+        cv::RNG rng(seed);
+
+        // The texture is padded so that the plane always covers the frame.
+        const cv::Size padding(
+            static_cast<int>(std::ceil(2.0f * MOTION_AMPLITUDE * static_cast<float>(resolution.width))),
+            static_cast<int>(std::ceil(2.0f * MOTION_AMPLITUDE * static_cast<float>(resolution.height)))
+        );
+        cv::Mat texture(resolution + padding * 2, CV_8UC3);
+
+        // Smooth noise as a base, with sharp shapes on top for corner features.
+        rng.fill(texture, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(255));
+        cv::GaussianBlur(texture, texture, cv::Size(0, 0), 4.0);
+
+        const auto shapes = static_cast<int>(TEXTURE_SHAPE_DENSITY * texture.size().area() / 1e6);
+        for(int i = 0; i < shapes; i++)
+        {
+            const cv::Point origin(rng.uniform(0, texture.cols), rng.uniform(0, texture.rows));
+            const cv::Size size(rng.uniform(4, 32), rng.uniform(4, 32));
+            const cv::Scalar colour(rng.uniform(0, 255), rng.uniform(0, 255), rng.uniform(0, 255));
+
+            cv::rectangle(texture, cv::Rect(origin, size), colour, cv::FILLED);
+        }
+
+        cv::cvtColor(texture, texture, cv::COLOR_BGR2YUV);
+        texture.copyTo(m_Texture);
+        m_Texture.format = lvk::VideoFrame::YUV;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void SyntheticVideo::next(lvk::VideoFrame& frame, const lvk::VideoFrame::Format format)
+    {
+        const cv::Point2f last_position = position_of(m_FrameCount);
+        const cv::Point2f position = position_of(++m_FrameCount);
+        m_Motion = position - last_position;
+
+        // Crop the frame out of the texture at the plane's position.
+        const cv::Point2f texture_centre(
+            static_cast<float>(m_Texture.cols) / 2.0f,
+            static_cast<float>(m_Texture.rows) / 2.0f
+        );
+        const cv::Point2f origin = texture_centre - cv::Point2f(m_Resolution) / 2.0f - position;
+
+        const cv::Matx23d translation(1, 0, -origin.x, 0, 1, -origin.y);
+        cv::warpAffine(m_Texture, frame, translation, m_Resolution, cv::INTER_LINEAR, cv::BORDER_REFLECT);
+
+        frame.timestamp = m_FrameCount;
+        frame.format = lvk::VideoFrame::YUV;
+        frame.reformat(format);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const cv::Point2f& SyntheticVideo::motion() const
+    {
+        return m_Motion;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t SyntheticVideo::frame_count() const
+    {
+        return m_FrameCount;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const cv::Size& SyntheticVideo::resolution() const
+    {
+        return m_Resolution;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Point2f SyntheticVideo::position_of(const uint64_t frame) const
+    {
+        // Lissajous path, with a different frequency on each axis.
+        const double phase = 2.0 * std::numbers::pi * static_cast<double>(frame % m_Period) / m_Period;
+
+        return {
+            MOTION_AMPLITUDE * static_cast<float>(m_Resolution.width * std::sin(phase)),
+            MOTION_AMPLITUDE * static_cast<float>(m_Resolution.height * std::sin(2.0 * phase))
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}
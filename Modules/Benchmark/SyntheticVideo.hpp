@@ -0,0 +1,55 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+
+namespace bench
+{
+
+    // Generates a deterministic video of a textured plane moving with
+    // a known smooth motion. The motion is periodic, so the video can
+    // be played indefinitely without any discontinuities.
+    class SyntheticVideo
+    {
+    public:
+
+        explicit SyntheticVideo(const cv::Size& resolution, const uint32_t period = 120, const uint64_t seed = 1);
+
+        void next(lvk::VideoFrame& frame, const lvk::VideoFrame::Format format = lvk::VideoFrame::YUV);
+
+        // Motion of the plane between the last two generated frames.
+        const cv::Point2f& motion() const;
+
+        uint64_t frame_count() const;
+
+        const cv::Size& resolution() const;
+
+    private:
+
+        cv::Point2f position_of(const uint64_t frame) const;
+
+    private:
+        cv::Size m_Resolution;
+        uint32_t m_Period = 0;
+        uint64_t m_FrameCount = 0;
+        cv::Point2f m_Motion{0, 0};
+        lvk::VideoFrame m_Texture;
+    };
+
+}
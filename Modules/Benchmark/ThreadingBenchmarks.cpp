@@ -0,0 +1,107 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmark.hpp"
+
+#include <thread>
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Blurs many 1080p images at once, where each blur is itself parallelized by OpenCV. Ad hoc
+    // threads each fan out onto OpenCV's own pool, oversubscribing the cores, while the task
+    // pool runs both levels of parallelism on the same workers.
+    static void BM_NestedParallelism(benchmark::State& state)
+    {
+        const auto job_count = static_cast<int>(state.range(0));
+        const bool pooled = state.range(1) != 0;
+
+        std::vector<cv::Mat> images(job_count), blurred(job_count);
+        for(auto& image : images)
+        {
+            image.create(resolution_of(1080), CV_8UC3);
+            cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+        }
+
+        const auto blur = [&](const int i){
+            cv::GaussianBlur(images[i], blurred[i], cv::Size(9, 9), 0.0);
+        };
+
+        lvk::TaskPool::route_opencv(pooled);
+        for(auto _ : state)
+        {
+            if(pooled)
+            {
+                lvk::parallel_for(cv::Range(0, job_count), [&](const cv::Range& jobs){
+                    for(int i = jobs.start; i < jobs.end; i++)
+                        blur(i);
+                });
+            }
+            else
+            {
+                std::vector<std::thread> threads;
+                for(int i = 0; i < job_count; i++)
+                    threads.emplace_back(blur, i);
+
+                for(auto& thread : threads)
+                    thread.join();
+            }
+        }
+        lvk::TaskPool::route_opencv(false);
+
+        state.SetItemsProcessed(state.iterations() * job_count);
+    }
+    BENCHMARK(BM_NestedParallelism)
+        ->ArgNames({"jobs", "pooled"})
+        ->ArgsProduct({{4, 8, 16}, {0, 1}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Measures the dispatch overhead of a fine-grained parallel loop.
+    static void BM_ParallelFor(benchmark::State& state)
+    {
+        const auto length = static_cast<int>(state.range(0));
+        const bool pooled = state.range(1) != 0;
+
+        std::vector<float> values(length, 1.0f);
+        const auto body = [&](const cv::Range& range){
+            for(int i = range.start; i < range.end; i++)
+                values[i] = std::sqrt(values[i] + 1.0f);
+        };
+
+        for(auto _ : state)
+        {
+            if(pooled)
+                lvk::parallel_for(cv::Range(0, length), body);
+            else
+                cv::parallel_for_(cv::Range(0, length), body);
+
+            benchmark::DoNotOptimize(values.data());
+        }
+        state.SetItemsProcessed(state.iterations() * length);
+    }
+    BENCHMARK(BM_ParallelFor)
+        ->ArgNames({"length", "pooled"})
+        ->ArgsProduct({{1024, 65536, 1048576}, {0, 1}})
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime();
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,109 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "Benchmark.hpp"
+
+namespace bench
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_FrameTracker_Track(benchmark::State& state)
+    {
+        const ThreadScope threads(static_cast<int>(state.range(1)));
+        SyntheticVideo video(resolution_of(state.range(0)));
+
+        lvk::FrameTracker tracker;
+        lvk::VideoFrame frame;
+        for(auto _ : state)
+        {
+            state.PauseTiming();
+            video.next(frame, lvk::VideoFrame::GRAY);
+            sync_gpu();
+            state.ResumeTiming();
+
+            benchmark::DoNotOptimize(tracker.track(frame));
+            sync_gpu();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_FrameTracker_Track)->Apply(resolution_and_threads);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_FeatureDetector_Detect(benchmark::State& state)
+    {
+        const ThreadScope threads(static_cast<int>(state.range(1)));
+
+        // Detection runs at a fixed square resolution, independent of the video.
+        const cv::Size detection_resolution(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+        SyntheticVideo video(detection_resolution);
+
+        lvk::FeatureDetectorSettings settings;
+        settings.detection_resolution = detection_resolution;
+        lvk::FeatureDetector detector(settings);
+
+        lvk::VideoFrame frame;
+        std::vector<cv::KeyPoint> features;
+        for(auto _ : state)
+        {
+            state.PauseTiming();
+            video.next(frame, lvk::VideoFrame::GRAY);
+            sync_gpu();
+            state.ResumeTiming();
+
+            benchmark::DoNotOptimize(detector.detect(frame, features));
+            sync_gpu();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_FeatureDetector_Detect)
+        ->ArgNames({"resolution", "threads"})
+        ->ArgsProduct({{256, 512, 1024}, {1, 4, 8}})
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime();
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    static void BM_PathSmoother_Next(benchmark::State& state)
+    {
+        const ThreadScope threads(static_cast<int>(state.range(1)));
+        const cv::Size mesh_size(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+
+        lvk::PathSmootherSettings settings;
+        settings.motion_resolution = mesh_size;
+        lvk::PathSmoother smoother(settings);
+
+        // Smooth periodic translations, in normalized units.
+        uint64_t frame = 0;
+        lvk::WarpMesh motion(mesh_size);
+        for(auto _ : state)
+        {
+            const auto time = static_cast<float>(frame++);
+            motion.set_to(cv::Point2f(std::sin(time * 0.10f), std::cos(time * 0.07f)) * 0.01f);
+
+            benchmark::DoNotOptimize(smoother.next(motion));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_PathSmoother_Next)
+        ->ArgNames({"mesh", "threads"})
+        ->ArgsProduct({{2, 4, 8, 16, 32}, {1, 4, 8}})
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime();
+
+//---------------------------------------------------------------------------------------------------------------------
+}
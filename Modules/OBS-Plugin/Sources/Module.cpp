@@ -19,6 +19,8 @@
 #include <obs-module.h>
 #include <opencv2/core/ocl.hpp>
 
+#include <LiveVisionKit.hpp>
+
 #include "Interop/InteropContext.hpp"
 #include "Utility/Logging.hpp"
 
@@ -68,7 +70,16 @@ void attach_ocl_interop_context(void* param, uint32_t cx, uint32_t cy)
 	// also need to attempt it repeatedly in case OBS switches to a new graphics
 	// render thread. If this happens, then our OpenCL execution context will be
 	// attached to the wrong thread, and must be updated before running OpenCL code.
-	lvk::ocl::InteropContext::TryAttach();
+	if(lvk::ocl::InteropContext::TryAttach())
+	{
+		// Programs are compiled per context, so must be warmed up within the interop context.
+		static bool programs_warm = false;
+		if(!programs_warm)
+		{
+			lvk::ocl::warmup_programs();
+			programs_warm = true;
+		}
+	}
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -109,6 +120,8 @@ bool obs_module_load()
 	// Attach OpenCL context
 	if(has_interop)
 		obs_add_main_render_callback(&attach_ocl_interop_context, nullptr);
+	else if(has_opencl)
+		lvk::ocl::warmup_programs();
 
 	// Register Filters...
 	register_fsr_source();
@@ -62,6 +62,9 @@ namespace lvk
 	constexpr auto PROP_BACKGROUND_COLOUR = "BACKGROUND_COL";
 	constexpr auto PROP_BACKGROUND_COLOUR_DEFAULT = 0x000000;
 
+    constexpr auto PROP_ADAPTIVE_QUALITY = "ADAPTIVE_QUALITY";
+    constexpr auto PROP_ADAPTIVE_QUALITY_DEFAULT = false;
+
 	constexpr auto PROP_STAB_DISABLED = "STAB_DISABLED";
 	constexpr auto PROP_STAB_DISABLED_DEFAULT = false;
 
@@ -175,6 +178,13 @@ namespace lvk
             controls
         );
 
+        // Adaptive Quality Toggle
+        obs_properties_add_bool(
+            controls,
+            PROP_ADAPTIVE_QUALITY,
+            L("vs.adaptive")
+        );
+
         // Disable Stabilization Toggle
 		obs_properties_add_bool(
             controls,
@@ -212,6 +222,7 @@ namespace lvk
 		obs_data_set_default_int(settings, PROP_BACKGROUND_COLOUR, PROP_BACKGROUND_COLOUR_DEFAULT);
         obs_data_set_default_double(settings, PROP_CROP_PERCENTAGE_X, PROP_CROP_PERCENTAGE_DEFAULT);
         obs_data_set_default_double(settings, PROP_CROP_PERCENTAGE_Y, PROP_CROP_PERCENTAGE_DEFAULT);
+        obs_data_set_default_bool(settings, PROP_ADAPTIVE_QUALITY, PROP_ADAPTIVE_QUALITY_DEFAULT);
 		obs_data_set_default_bool(settings, PROP_STAB_DISABLED, PROP_STAB_DISABLED_DEFAULT);
         obs_data_set_default_int(settings, PROP_INDEP_CROP, PROP_INDEP_CROP_DEFAULT);
         obs_data_set_default_string(settings, PROP_SUBSYSTEM, PROP_SUBSYSTEM_DEFAULT);
@@ -279,6 +290,10 @@ namespace lvk
                 stab_settings.accumulation_rate = 3.0f;
             }
 
+            // The adaptive quality governor targets the same frame time that the HUD does.
+            stab_settings.frame_time_budget = obs_data_get_bool(settings, PROP_ADAPTIVE_QUALITY)
+                ? Time::Milliseconds(TIMING_THRESHOLD_MS) : Time();
+
             // Configure quality assurance
             const std::string quality_assurance = obs_data_get_string(settings, PROP_QUALITY_ASSURANCE);
             if(quality_assurance == PROP_QUALITY_ASSURANCE_STRICT)
@@ -322,6 +337,7 @@ namespace lvk
             "\n    Subsystem: %s"
             "\n    Crop Percentage: (%.1f%%,%.1f%%)"
             "\n    Auto-apply Crop: %s"
+            "\n    Adaptive Quality: %s"
             "\n    Disable Stabilization: %s"
             "\n    Test Mode: %s",
             m_Filter.settings().predictive_samples,
@@ -330,6 +346,7 @@ namespace lvk
             m_Filter.settings().corrective_limits.width * 100.0f,
             m_Filter.settings().corrective_limits.height * 100.0f,
             m_Filter.settings().crop_to_stable_region ? "Yes" : "No",
+            m_Filter.settings().frame_time_budget.is_zero() ? "No" : "Yes",
             m_Filter.settings().stabilize_output ? "No" : "Yes",
             m_TestMode ? "Yes" : "No"
         );
@@ -361,6 +378,18 @@ namespace lvk
             draw_debug_hud(frame);
         }
         else m_Filter.apply(std::move(frame), frame);
+
+        // Log every change made by the adaptive quality governor.
+        if(const auto quality_level = m_Filter.quality_level(); quality_level != m_QualityLevel)
+        {
+            log::print(
+                "Stabilizer quality level changed from %zu to %zu (%.2fms frame time)",
+                m_QualityLevel,
+                quality_level,
+                m_Filter.timings().average().milliseconds()
+            );
+            m_QualityLevel = quality_level;
+        }
 	}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -371,6 +400,8 @@ namespace lvk
 
 		const double frame_time_ms = m_Filter.timings().average().milliseconds();
 		const double deviation_ms = m_Filter.timings().deviation().milliseconds();
+		const auto& histogram = m_Filter.timings().histogram();
+		const double p99_ms = histogram.percentile(99.0).milliseconds();
 		const auto& crop_region = m_Filter.stable_region();
 
 		draw_text(
@@ -379,6 +410,22 @@ namespace lvk
 			crop_region.tl() + cv::Point(5, 40),
 			frame_time_ms < TIMING_THRESHOLD_MS ? col::GREEN[frame.format] : col::RED[frame.format]
 		);
+
+		// Tail latencies, the p99 is coloured as it is what drops frames.
+		draw_text(
+			frame,
+			cv::format(
+				"p50 %.2fms  p90 %.2fms  p99 %.2fms  p99.9 %.2fms  max %.2fms",
+				histogram.percentile(50.0).milliseconds(),
+				histogram.percentile(90.0).milliseconds(),
+				p99_ms,
+				histogram.percentile(99.9).milliseconds(),
+				histogram.max().milliseconds()
+			),
+			crop_region.tl() + cv::Point(5, 80),
+			p99_ms < TIMING_THRESHOLD_MS ? col::GREEN[frame.format] : col::RED[frame.format],
+			1.0
+		);
 		draw_rect(frame, crop_region, col::MAGENTA[frame.format]);
 	}
 
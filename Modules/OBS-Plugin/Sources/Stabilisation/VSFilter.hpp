@@ -53,6 +53,7 @@ namespace lvk
 
 		StabilizationFilter m_Filter;
 		bool m_TestMode = false;
+        size_t m_QualityLevel = 0;
 	};
 
 }
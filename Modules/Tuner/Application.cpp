@@ -0,0 +1,151 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include <LiveVisionKit.hpp>
+#include <iostream>
+#include <fstream>
+#include <deque>
+
+#include "StabilizationTuner.hpp"
+
+constexpr double DEFAULT_TARGET_MS = 1000.0 / 60.0;
+constexpr size_t DEFAULT_TRIALS = 48;
+constexpr size_t DEFAULT_CLIP_FRAMES = 300;
+
+constexpr auto USAGE =
+    "Usage: lvk-tune <clip> <profile> [options]\n\n"
+    "Replays the clip through the stabilizer while searching for the settings with the best trade-off\n"
+    "between frame time and output stability. The Pareto front is printed to stdout, and the most stable\n"
+    "point within the target frame time is written as a profile which can be loaded by lvk-editor -p.\n\n"
+    "Options:\n"
+    "    --target <ms>    The target frame time of the stabilizer (default 16.67ms)\n"
+    "    --trials <n>     The number of settings to evaluate (default 48)\n"
+    "    --frames <n>     The maximum number of clip frames to replay (default 300)\n"
+    "    --seed <n>       The seed of the random search (default 1)\n";
+
+//---------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    // Fail loudly on any LVK assert, as the results would be meaningless.
+    lvk::context::assert_handler = [](auto, auto, const std::string& assertion){
+        std::cerr << cv::format("LiveVisionKit failed condition: %s\n", assertion.c_str());
+        std::abort();
+    };
+
+    std::deque<std::string> arguments(argv + 1, argv + argc);
+    if(arguments.size() < 2)
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
+    const std::filesystem::path clip_path = arguments[0];
+    const std::filesystem::path profile_path = arguments[1];
+    arguments.erase(arguments.begin(), arguments.begin() + 2);
+
+    // NOTE: the video editor only loads profiles which have a file extension.
+    if(!profile_path.has_extension())
+    {
+        std::cerr << cv::format("Profile \'%s\' must have a file extension\n", profile_path.string().c_str());
+        return 1;
+    }
+
+    double target_ms = DEFAULT_TARGET_MS;
+    size_t trials = DEFAULT_TRIALS, clip_frames = DEFAULT_CLIP_FRAMES;
+    uint64_t seed = 1;
+    try
+    {
+        while(arguments.size() >= 2)
+        {
+            const auto option = arguments[0], value = arguments[1];
+            arguments.erase(arguments.begin(), arguments.begin() + 2);
+
+            if(option == "--target")
+                target_ms = std::stod(value);
+            else if(option == "--trials")
+                trials = std::stoull(value);
+            else if(option == "--frames")
+                clip_frames = std::stoull(value);
+            else if(option == "--seed")
+                seed = std::stoull(value);
+            else
+                throw std::invalid_argument(option);
+        }
+
+        if(!arguments.empty() || target_ms <= 0.0 || trials == 0)
+            throw std::invalid_argument("");
+    }
+    catch(const std::exception&)
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
+    tune::StabilizationTuner tuner;
+    if(const auto error = tuner.load_clip(clip_path, clip_frames); error.has_value())
+    {
+        std::cerr << *error << "\n";
+        return 1;
+    }
+
+    const auto resolution = tuner.resolution();
+    std::cerr << cv::format(
+        "Tuning against \'%s\' at %dx%d with a %.2fms target...\n",
+        clip_path.string().c_str(),
+        resolution.width,
+        resolution.height,
+        target_ms
+    );
+
+    const auto front = tune::StabilizationTuner::pareto_front(tuner.search(trials, seed));
+
+    // Choose the most stable point within the target, or the cheapest point if none fit.
+    size_t choice = 0;
+    for(size_t i = 0; i < front.size(); i++)
+    {
+        if(front[i].frame_time_ms <= target_ms)
+            choice = i;
+    }
+
+    std::cout << "Pareto front (frame time, p99, jitter, profile):\n";
+    for(size_t i = 0; i < front.size(); i++)
+    {
+        std::cout << cv::format(
+            "%c %7.2fms %7.2fms %8.3fpx   %s",
+            i == choice ? '*' : ' ',
+            front[i].frame_time_ms,
+            front[i].p99_frame_time_ms,
+            front[i].jitter_px,
+            tune::StabilizationTuner::to_profile(front[i].settings).c_str()
+        );
+    }
+
+    std::ofstream profile(profile_path);
+    profile << tune::StabilizationTuner::to_profile(front[choice].settings);
+    if(!profile.good())
+    {
+        std::cerr << cv::format("Failed to write profile \'%s\'\n", profile_path.string().c_str());
+        return 1;
+    }
+
+    if(front[choice].frame_time_ms > target_ms)
+        std::cerr << "No settings met the target, wrote the cheapest settings instead\n";
+    std::cerr << cv::format("Wrote profile \'%s\'\n", profile_path.string().c_str());
+
+    return 0;
+}
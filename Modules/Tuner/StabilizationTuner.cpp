@@ -0,0 +1,292 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "StabilizationTuner.hpp"
+
+#include <iostream>
+#include <limits>
+#include <set>
+
+namespace tune
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr size_t MIN_CLIP_FRAMES = 60;
+    constexpr size_t WARMUP_FRAMES = 10;
+    constexpr size_t MAX_REFINEMENT_STALLS = 32;
+
+    // The tuning space, each setting is listed from cheapest to most expensive.
+    const std::array<cv::Size, 4> DETECTION_RESOLUTIONS = {{{256, 144}, {384, 216}, {480, 270}, {640, 360}}};
+    const std::array<cv::Size, 4> DETECTION_REGIONS = {{{1, 1}, {2, 1}, {2, 2}, {3, 3}}};
+    const std::array<cv::Size, 3> MOTION_RESOLUTIONS = {{{2, 2}, {8, 8}, {16, 16}}};
+    constexpr std::array<size_t, 4> PREDICTIVE_SAMPLES = {5, 10, 15, 20};
+    constexpr std::array<size_t, 4> MIN_MOTION_SAMPLES = {50, 75, 100, 150};
+
+    constexpr std::array<size_t, 5> SPACE_DIMENSIONS = {
+        DETECTION_RESOLUTIONS.size(),
+        DETECTION_REGIONS.size(),
+        MOTION_RESOLUTIONS.size(),
+        PREDICTIVE_SAMPLES.size(),
+        MIN_MOTION_SAMPLES.size()
+    };
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    StabilizationTuner::StabilizationTuner()
+    {
+        // The reference tracker only measures the global motion left in the output,
+        // so it is kept fixed across all trials to make their jitter comparable.
+        lvk::FrameTrackerSettings reference_settings;
+        reference_settings.detection_resolution = {640, 360};
+        reference_settings.motion_resolution = lvk::WarpMesh::MinimumSize;
+        reference_settings.track_local_motions = false;
+
+        m_ReferenceTracker.configure(reference_settings);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> StabilizationTuner::load_clip(const std::filesystem::path& path, const size_t max_frames)
+    {
+        cv::VideoCapture capture(path.string());
+        if(!capture.isOpened())
+            return cv::format("Failed to open clip \'%s\'", path.string().c_str());
+
+        // Predecode the clip, so that decoding is never part of the measured cost.
+        m_Clip.clear();
+        m_Clip.reserve(max_frames);
+
+        lvk::VideoFrame frame;
+        while(m_Clip.size() < max_frames && capture.read(frame))
+        {
+            frame.format = lvk::VideoFrame::BGR;
+            m_Clip.push_back(std::move(frame));
+        }
+
+        if(m_Clip.size() < MIN_CLIP_FRAMES)
+        {
+            return cv::format(
+                "Clip \'%s\' is too short, replayed %zu frames, expected at least %zu",
+                path.string().c_str(),
+                m_Clip.size(),
+                MIN_CLIP_FRAMES
+            );
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<TuningPoint> StabilizationTuner::search(const size_t trials, const uint64_t seed)
+    {
+        LVK_ASSERT(!m_Clip.empty());
+        LVK_ASSERT(trials > 0);
+
+        size_t space_size = 1;
+        for(const auto dimension : SPACE_DIMENSIONS)
+            space_size *= dimension;
+
+        cv::RNG rng(seed);
+        const auto random_index = [&](){
+            std::array<size_t, 5> index = {};
+            for(size_t d = 0; d < index.size(); d++)
+                index[d] = static_cast<size_t>(rng.uniform(0, static_cast<int>(SPACE_DIMENSIONS[d])));
+            return index;
+        };
+
+        // Spend the first half of the budget exploring the space randomly, then the rest
+        // refining the Pareto front by stepping a single setting of one of its points.
+        const size_t exploration_trials = std::max<size_t>(trials / 2, 1);
+
+        std::vector<TuningPoint> points;
+        std::set<std::array<size_t, 5>> visited;
+        size_t stalls = 0;
+        while(points.size() < std::min(trials, space_size))
+        {
+            std::array<size_t, 5> index;
+            if(points.size() < exploration_trials || stalls >= MAX_REFINEMENT_STALLS)
+                index = random_index();
+            else
+            {
+                const auto front = pareto_front(points);
+                index = front[static_cast<size_t>(rng.uniform(0, static_cast<int>(front.size())))].index;
+
+                const auto d = static_cast<size_t>(rng.uniform(0, static_cast<int>(index.size())));
+                if(rng.uniform(0, 2) == 0)
+                    index[d] = index[d] > 0 ? index[d] - 1 : index[d] + 1;
+                else
+                    index[d] = index[d] + 1 < SPACE_DIMENSIONS[d] ? index[d] + 1 : index[d] - 1;
+            }
+
+            // Every point in the space only ever needs to be evaluated once.
+            if(!visited.insert(index).second)
+            {
+                stalls++;
+                continue;
+            }
+            stalls = 0;
+
+            const auto& point = points.emplace_back(evaluate(index));
+            std::cerr << cv::format(
+                "Trial %zu/%zu: %.2fms (p99 %.2fms), %.3fpx jitter\n",
+                points.size(),
+                std::min(trials, space_size),
+                point.frame_time_ms,
+                point.p99_frame_time_ms,
+                point.jitter_px
+            );
+        }
+
+        return points;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    TuningPoint StabilizationTuner::evaluate(const std::array<size_t, 5>& index)
+    {
+        TuningPoint point;
+        point.index = index;
+
+        auto& settings = point.settings;
+        settings.detection_resolution = DETECTION_RESOLUTIONS[index[0]];
+        settings.detection_regions = DETECTION_REGIONS[index[1]];
+        settings.motion_resolution = MOTION_RESOLUTIONS[index[2]];
+        settings.track_local_motions = settings.motion_resolution != lvk::WarpMesh::MinimumSize;
+        settings.predictive_samples = PREDICTIVE_SAMPLES[index[3]];
+        settings.min_motion_samples = MIN_MOTION_SAMPLES[index[4]];
+
+        // NOTE: the output is cropped so the background never enters the jitter measurement.
+        settings.crop_to_stable_region = true;
+
+        lvk::StabilizationFilter filter(settings);
+
+        m_ReferenceTracker.restart();
+        m_LastVelocity.reset();
+        m_JitterSum = 0.0;
+        m_JitterSamples = 0;
+
+        lvk::Stopwatch timer(m_Clip.size());
+        lvk::VideoFrame input_frame, output_frame;
+        for(size_t i = 0; i < m_Clip.size(); i++)
+        {
+            // NOTE: the filter takes ownership of its input, so the frame must be copied.
+            m_Clip[i].copyTo(input_frame);
+
+            timer.start();
+            filter.apply(std::move(input_frame), output_frame, false);
+            timer.sync_gpu().stop();
+
+            // The first frames include all the allocations and kernel compilations.
+            if(i + 1 == WARMUP_FRAMES)
+                timer.reset_history();
+
+            if(!output_frame.empty())
+                measure_jitter(output_frame);
+        }
+
+        point.frame_time_ms = timer.average().milliseconds();
+        point.p99_frame_time_ms = timer.histogram().percentile(99.0).milliseconds();
+        point.jitter_px = m_JitterSamples > 0
+            ? std::sqrt(m_JitterSum / static_cast<double>(m_JitterSamples))
+            : std::numeric_limits<double>::infinity();
+
+        return point;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void StabilizationTuner::measure_jitter(const lvk::VideoFrame& output)
+    {
+        output.viewAsFormat(m_TrackingFrame, lvk::VideoFrame::GRAY);
+
+        // A discontinuity in the tracking also breaks the path.
+        const auto motion = m_ReferenceTracker.track(m_TrackingFrame);
+        if(!motion.has_value())
+        {
+            m_LastVelocity.reset();
+            return;
+        }
+
+        // The jitter is the RMS acceleration of the output path, which is zero
+        // for any smooth camera motion that the stabilizer should leave intact.
+        const auto mean_offset = cv::mean(motion->offsets());
+        const cv::Point2f velocity(
+            static_cast<float>(mean_offset[0]) * static_cast<float>(output.cols),
+            static_cast<float>(mean_offset[1]) * static_cast<float>(output.rows)
+        );
+
+        if(m_LastVelocity.has_value())
+        {
+            const auto acceleration = velocity - *m_LastVelocity;
+            m_JitterSum += acceleration.dot(acceleration);
+            m_JitterSamples++;
+        }
+        m_LastVelocity = velocity;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::vector<TuningPoint> StabilizationTuner::pareto_front(const std::vector<TuningPoint>& points)
+    {
+        const auto dominates = [](const TuningPoint& a, const TuningPoint& b){
+            return a.frame_time_ms <= b.frame_time_ms && a.jitter_px <= b.jitter_px
+                && (a.frame_time_ms < b.frame_time_ms || a.jitter_px < b.jitter_px);
+        };
+
+        std::vector<TuningPoint> front;
+        for(const auto& point : points)
+        {
+            const bool dominated = std::any_of(points.begin(), points.end(), [&](const TuningPoint& other){
+                return dominates(other, point);
+            });
+            if(!dominated) front.push_back(point);
+        }
+
+        std::sort(front.begin(), front.end(), [](const TuningPoint& a, const TuningPoint& b){
+            return a.frame_time_ms < b.frame_time_ms;
+        });
+
+        return front;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::string StabilizationTuner::to_profile(const lvk::StabilizationFilterSettings& settings)
+    {
+        // NOTE: written as the video editor's filter options, so it can be loaded with -p.
+        return cv::format(
+            "-f vs .dr %dx%d .rg %dx%d .mr %dx%d .s %zu .ms %zu\n",
+            settings.detection_resolution.width, settings.detection_resolution.height,
+            settings.detection_regions.width, settings.detection_regions.height,
+            settings.motion_resolution.width, settings.motion_resolution.height,
+            settings.predictive_samples,
+            settings.min_motion_samples
+        );
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Size StabilizationTuner::resolution() const
+    {
+        LVK_ASSERT(!m_Clip.empty());
+
+        return m_Clip.front().size();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,80 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include <array>
+
+namespace tune
+{
+
+    struct TuningPoint
+    {
+        // NOTE: indices into the tuning space for each of the tuned settings.
+        std::array<size_t, 5> index = {};
+
+        lvk::StabilizationFilterSettings settings;
+
+        // Mean filter cost, and the jitter left in the stabilized output.
+        double frame_time_ms = 0.0;
+        double p99_frame_time_ms = 0.0;
+        double jitter_px = 0.0;
+    };
+
+
+    // Replays a clip through the stabilizer to find the settings which give the best
+    // trade-off between cost and stability. The settings space is too large to search
+    // exhaustively, so it is sampled randomly, then refined around the Pareto front.
+    class StabilizationTuner
+    {
+    public:
+
+        StabilizationTuner();
+
+        std::optional<std::string> load_clip(const std::filesystem::path& path, const size_t max_frames);
+
+        std::vector<TuningPoint> search(const size_t trials, const uint64_t seed = 1);
+
+        static std::vector<TuningPoint> pareto_front(const std::vector<TuningPoint>& points);
+
+        static std::string to_profile(const lvk::StabilizationFilterSettings& settings);
+
+        cv::Size resolution() const;
+
+    private:
+
+        TuningPoint evaluate(const std::array<size_t, 5>& index);
+
+        void measure_jitter(const lvk::VideoFrame& output);
+
+    private:
+        std::vector<lvk::VideoFrame> m_Clip;
+
+        // Output path of the current trial, as measured by the reference tracker.
+        lvk::FrameTracker m_ReferenceTracker;
+        std::optional<cv::Point2f> m_LastVelocity;
+        lvk::VideoFrame m_TrackingFrame;
+        double m_JitterSum = 0.0;
+        size_t m_JitterSamples = 0;
+    };
+
+}
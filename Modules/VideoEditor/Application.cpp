@@ -20,6 +20,7 @@
 
 #include "VideoIOConfiguration.hpp"
 #include "VideoProcessor.hpp"
+#include "BatchProcessor.hpp"
 
 #ifdef WIN32
 #define NOMINMAX
@@ -50,13 +51,8 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    clt::VideoProcessor processor(configuration);
-
     // Set up signal to terminate the processor early on ctrl+c
-    signal_handler = [&](){
-        processor.stop();
-    };
-    signal(SIGINT, [](int s){signal_handler();});
+    signal(SIGINT, [](int s){if(signal_handler) signal_handler();});
 
     // Set up LVK assert handler
     lvk::context::assert_handler = [](auto, auto, const std::string& assertion){
@@ -71,8 +67,42 @@ int main(int argc, char* argv[])
     nice(-40);
 #endif
 
+    // Run OpenCV's parallel loops on the shared task pool, so that nested
+    // parallelism across filters and jobs does not oversubscribe the cores.
+    lvk::TaskPool::route_opencv();
+
+    // Track the memory allocated by each filter, before any processing starts.
+    lvk::MemoryTracker::install();
+
+    // Compile all OpenCL programs before processing starts.
+    lvk::ocl::warmup_programs();
+
+
+    // Run all batch jobs, sharing the OpenCL programs and thread budget.
+    if(configuration.batch_manifest.has_value())
+    {
+        clt::BatchProcessor batch(configuration);
+        signal_handler = [&](){
+            batch.stop();
+        };
+
+        if(auto error = batch.run(); error.has_value())
+        {
+            std::cerr << *error << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    if(configuration.thread_budget.has_value())
+        cv::setNumThreads(static_cast<int>(*configuration.thread_budget));
 
     // Run the video processor
+    clt::VideoProcessor processor(configuration);
+    signal_handler = [&](){
+        processor.stop();
+    };
+
     if(auto error = processor.run(); error.has_value())
     {
         std::cerr << *error << "\n";
@@ -0,0 +1,188 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "AsyncSink.hpp"
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    AsyncSink::AsyncSink(std::unique_ptr<VideoSink> sink, const size_t capacity, const size_t timing_samples)
+        : m_Sink(std::move(sink)),
+          m_Capacity(capacity),
+          m_EncodeTimer(timing_samples)
+    {
+        LVK_ASSERT(m_Sink != nullptr);
+
+        if(m_Capacity > 0)
+            m_WriterThread.emplace(&AsyncSink::run_writer, this);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    AsyncSink::~AsyncSink()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool AsyncSink::write(const lvk::VideoFrame& frame)
+    {
+        if(m_Failed) return false;
+
+        if(!m_WriterThread.has_value())
+            return encode(frame);
+
+        std::unique_lock<std::mutex> queue_lock(m_QueueMutex);
+        LVK_ASSERT(!m_Finished);
+
+        // If the queue is saturated, the encoder is the bottleneck so we must wait.
+        if(m_Queue.size() >= m_Capacity)
+        {
+            LVK_TRACE_CATEGORY("Wait (Encoder Full)", "stream");
+
+            const auto wait_start = lvk::Time::Now();
+            while(m_Queue.size() >= m_Capacity && !m_Failed)
+                m_ConsumeFlag.wait(queue_lock);
+
+            std::scoped_lock statistics_lock(m_StatisticsMutex);
+            m_BlockedTime += lvk::Time::Now() - wait_start;
+        }
+
+        // NOTE: this is a shallow copy, the frame's data is shared with the caller.
+        m_Queue.push(frame);
+        if(m_Queue.size() == 1)
+            m_AvailableFlag.notify_one();
+
+        std::scoped_lock statistics_lock(m_StatisticsMutex);
+        m_QueuePeak = std::max(m_QueuePeak, m_Queue.size());
+
+        return !m_Failed;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void AsyncSink::run_writer()
+    {
+        lvk::Trace::set_thread_name("Stream Encoder");
+
+        lvk::VideoFrame frame;
+        while(true)
+        {
+            // Pop the next frame from the queue
+            {
+                std::unique_lock<std::mutex> queue_lock(m_QueueMutex);
+                while(m_Queue.empty())
+                {
+                    // If there are no more frames incoming, then everything has been written.
+                    if(m_Finished) return;
+
+                    m_AvailableFlag.wait(queue_lock);
+                }
+
+                frame = std::move(m_Queue.front());
+                m_Queue.pop();
+
+                m_ConsumeFlag.notify_one();
+            }
+
+            // Keep draining the queue on failure so the producer is never stuck waiting.
+            if(!m_Failed && !encode(frame))
+            {
+                std::scoped_lock queue_lock(m_QueueMutex);
+                m_Failed = true;
+                m_ConsumeFlag.notify_one();
+            }
+            frame.release();
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool AsyncSink::encode(const lvk::VideoFrame& frame)
+    {
+        LVK_TRACE_CATEGORY("Encode Frame", "stream");
+
+        // NOTE: the timer is only started by one thread, so only the
+        // stop needs to be locked as it updates the timing history.
+        m_EncodeTimer.start();
+        const bool success = m_Sink->write(frame);
+
+        std::scoped_lock statistics_lock(m_StatisticsMutex);
+        m_EncodeTimer.stop();
+        m_FramesWritten++;
+
+        return success;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool AsyncSink::is_open() const
+    {
+        return !m_Failed && m_Sink->is_open();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void AsyncSink::close()
+    {
+        if(m_WriterThread.has_value())
+        {
+            {
+                std::scoped_lock queue_lock(m_QueueMutex);
+                m_Finished = true;
+                m_AvailableFlag.notify_one();
+            }
+            m_WriterThread->join();
+            m_WriterThread.reset();
+        }
+
+        if(m_Sink->is_open())
+            m_Sink->close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool AsyncSink::has_failed() const
+    {
+        return m_Failed;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    SinkStatistics AsyncSink::statistics() const
+    {
+        SinkStatistics statistics;
+        {
+            std::scoped_lock queue_lock(m_QueueMutex);
+            statistics.queue_depth = m_Queue.size();
+            statistics.queue_capacity = m_Capacity;
+        }
+
+        std::scoped_lock statistics_lock(m_StatisticsMutex);
+        statistics.queue_peak = m_QueuePeak;
+        statistics.frames_written = m_FramesWritten;
+        statistics.encode_time = m_EncodeTimer.average();
+        statistics.encode_deviation = m_EncodeTimer.deviation();
+        statistics.blocked_time = m_BlockedTime;
+
+        return statistics;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,94 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <condition_variable>
+#include <optional>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <queue>
+#include <mutex>
+
+#include "VideoSink.hpp"
+
+namespace clt
+{
+
+    struct SinkStatistics
+    {
+        size_t queue_depth = 0;
+        size_t queue_peak = 0;
+        size_t queue_capacity = 0;
+        uint64_t frames_written = 0;
+
+        lvk::Time encode_time;
+        lvk::Time encode_deviation;
+
+        // Total time the producer was blocked on a saturated queue.
+        lvk::Time blocked_time;
+    };
+
+
+    // Writes frames to the wrapped sink on a dedicated writer thread, so that
+    // encoding does not stall the producer unless the encoder is the bottleneck.
+    // NOTE: with a capacity of zero, frames are written synchronously.
+    class AsyncSink final : public VideoSink
+    {
+    public:
+
+        explicit AsyncSink(std::unique_ptr<VideoSink> sink, const size_t capacity = 8, const size_t timing_samples = 300);
+
+        ~AsyncSink() override;
+
+        // NOTE: frames are queued by reference and must not be modified after being written.
+        bool write(const lvk::VideoFrame& frame) override;
+
+        bool is_open() const override;
+
+        void close() override;
+
+        bool has_failed() const;
+
+        SinkStatistics statistics() const;
+
+    private:
+
+        void run_writer();
+
+        bool encode(const lvk::VideoFrame& frame);
+
+    private:
+        std::unique_ptr<VideoSink> m_Sink;
+        std::optional<std::thread> m_WriterThread;
+
+        const size_t m_Capacity;
+        std::queue<lvk::VideoFrame> m_Queue;
+        std::condition_variable m_ConsumeFlag, m_AvailableFlag;
+        mutable std::mutex m_QueueMutex;
+        bool m_Finished = false;
+        std::atomic<bool> m_Failed = false;
+
+        mutable std::mutex m_StatisticsMutex;
+        lvk::Stopwatch m_EncodeTimer;
+        lvk::Time m_BlockedTime;
+        uint64_t m_FramesWritten = 0;
+        size_t m_QueuePeak = 0;
+    };
+
+}
@@ -0,0 +1,314 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "BatchProcessor.hpp"
+
+#include <thread>
+#include <sstream>
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: each job already runs its own input, filter and output threads.
+    constexpr uint32_t THREADS_PER_JOB = 4;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    BatchProcessor::BatchProcessor(VideoIOConfiguration configuration)
+        : m_Configuration(std::move(configuration))
+    {}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BatchProcessor::load_manifest()
+    {
+        LVK_ASSERT(m_Configuration.batch_manifest.has_value());
+
+        std::ifstream manifest(*m_Configuration.batch_manifest);
+        if(!manifest.good())
+            return cv::format("Failed to open batch manifest \'%s\'", m_Configuration.batch_manifest->string().c_str());
+
+        m_Jobs.clear();
+        size_t line_number = 0;
+        for(std::string line; std::getline(manifest, line);)
+        {
+            line_number++;
+
+            // Skip empty lines and comments
+            std::stringstream line_stream(line);
+            std::string input, output, profile;
+            if(!(line_stream >> input) || input.starts_with('#'))
+                continue;
+
+            if(!(line_stream >> output))
+                return cv::format("Batch job on line %zu has no output", line_number);
+
+            auto& status = m_Jobs.emplace_back();
+            status.job.input = input;
+            status.job.output = output;
+            if(line_stream >> profile)
+                status.job.profile = profile;
+        }
+
+        if(m_Jobs.empty())
+            return "The batch manifest has no jobs";
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::stop()
+    {
+        // NOTE: this may be called from a signal handler, so the running
+        // jobs are stopped by the reporting loop rather than from here.
+        m_Terminate = true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> BatchProcessor::run()
+    {
+        if(auto error = load_manifest(); error.has_value())
+            return error;
+
+        if(m_Configuration.log_target.has_value())
+        {
+            m_DataLogStream.open(*m_Configuration.log_target);
+            if(!m_DataLogStream.good())
+                return "Failed to open data logging stream";
+
+            m_DataLogger.emplace(m_DataLogStream);
+        }
+
+        // Share the thread budget between all jobs. Filters draw their worker threads
+        // from the global task pool, which OpenCV is routed to, so it is limited to the budget.
+        const uint32_t thread_budget = m_Configuration.thread_budget.value_or(
+            std::max(std::thread::hardware_concurrency(), 1u)
+        );
+        cv::setNumThreads(static_cast<int>(thread_budget));
+
+        const auto worker_count = std::min<size_t>(
+            m_Configuration.batch_jobs.value_or(std::max(thread_budget / THREADS_PER_JOB, 1u)),
+            m_Jobs.size()
+        );
+
+        m_BatchTimer.start();
+
+        m_ActiveWorkers = worker_count;
+        std::vector<std::thread> workers;
+        for(size_t i = 0; i < worker_count; i++)
+            workers.emplace_back(&BatchProcessor::run_worker, this);
+
+        // Report on the jobs until all the workers have finished.
+        while(m_ActiveWorkers > 0)
+        {
+            // On termination, keep stopping the running jobs until the workers give up.
+            if(m_Terminate)
+            {
+                std::scoped_lock status_lock(m_StatusMutex);
+                for(auto& status : m_Jobs)
+                {
+                    if(status.processor != nullptr)
+                        status.processor->stop();
+                }
+            }
+
+            if(m_Configuration.print_progress)
+                print_progress();
+            log_finished_jobs();
+
+            std::this_thread::sleep_for(std::chrono::nanoseconds(
+                static_cast<int64_t>(m_Configuration.update_period.nanoseconds())
+            ));
+        }
+
+        for(auto& worker : workers)
+            worker.join();
+
+        if(m_Configuration.print_progress)
+            print_progress();
+        log_finished_jobs();
+
+        // Summarize any failed jobs
+        std::string failures;
+        size_t failure_count = 0;
+        for(size_t i = 0; i < m_Jobs.size(); i++)
+        {
+            if(m_Jobs[i].state == JobState::FAILED)
+            {
+                failure_count++;
+                failures += cv::format(
+                    "\n   [%zu] %s: %s",
+                    i,
+                    m_Jobs[i].job.input.string().c_str(),
+                    m_Jobs[i].error.value_or("unknown error").c_str()
+                );
+            }
+        }
+
+        if(failure_count > 0)
+            return cv::format("%zu of %zu batch jobs failed", failure_count, m_Jobs.size()) + failures;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::run_worker()
+    {
+        lvk::Trace::set_thread_name("Batch Worker");
+
+        while(!m_Terminate)
+        {
+            const size_t index = m_NextJob++;
+            if(index >= m_Jobs.size())
+                break;
+
+            run_job(m_Jobs[index]);
+        }
+        m_ActiveWorkers--;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::run_job(JobStatus& status)
+    {
+        // Parse the job as though it was given on the command line.
+        ArgQueue arguments;
+        if(status.job.profile.has_value())
+        {
+            arguments.emplace_back("-p");
+            arguments.emplace_back(status.job.profile->string());
+        }
+        arguments.emplace_back(status.job.input.string());
+        arguments.emplace_back(status.job.output.string());
+
+        VideoIOConfiguration job_configuration;
+        auto error = job_configuration.from_arguments(std::move(arguments));
+
+        // NOTE: the batch reports the progress of all jobs instead.
+        job_configuration.print_progress = false;
+        job_configuration.render_output = false;
+
+        const auto processor = std::make_shared<VideoProcessor>(std::move(job_configuration));
+        {
+            std::scoped_lock status_lock(m_StatusMutex);
+            status.processor = processor;
+            status.state = JobState::RUNNING;
+            status.timer.start();
+        }
+
+        if(!error.has_value())
+            error = processor->run();
+
+        std::scoped_lock status_lock(m_StatusMutex);
+        status.elapsed = status.timer.stop();
+        status.frames = processor->frames_processed();
+        status.state = error.has_value() ? JobState::FAILED : JobState::FINISHED;
+        status.error = std::move(error);
+        status.processor.reset();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::print_progress()
+    {
+        std::scoped_lock status_lock(m_StatusMutex);
+
+        size_t finished = 0, running = 0, failed = 0;
+        for(const auto& status : m_Jobs)
+        {
+            finished += status.state == JobState::FINISHED;
+            running += status.state == JobState::RUNNING;
+            failed += status.state == JobState::FAILED;
+        }
+
+        m_ConsoleLogger.clear();
+        m_ConsoleLogger << "Batch: " << m_Configuration.batch_manifest->string()
+                        << "   " << finished << "/" << m_Jobs.size() << " finished"
+                        << ", " << running << " running"
+                        << ", " << failed << " failed"
+                        << ConsoleLogger::Next;
+
+        m_ConsoleLogger << "   Elapsed: " << m_BatchTimer.elapsed().hms() << ConsoleLogger::Next;
+
+        // Only list the jobs which are currently running
+        for(size_t i = 0; i < m_Jobs.size(); i++)
+        {
+            const auto& status = m_Jobs[i];
+            if(status.state != JobState::RUNNING || status.processor == nullptr)
+                continue;
+
+            const auto frames = status.processor->frames_processed();
+            const auto elapsed = status.timer.elapsed();
+            const double fps = elapsed.is_zero() ? 0.0 : static_cast<double>(frames) / elapsed.seconds();
+
+            m_ConsoleLogger << "   [" << i << "] " << status.job.input.filename().string();
+            if(const auto progress = status.processor->progress(); progress.has_value())
+                m_ConsoleLogger << "  " << cv::format("%0.1f%%", 100.0 * *progress);
+
+            m_ConsoleLogger << "   Frame: " << frames
+                            << "   FPS: " << std::fixed << std::setprecision(0) << fps
+                            << ConsoleLogger::Next;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void BatchProcessor::log_finished_jobs()
+    {
+        if(!m_DataLogger.has_value())
+            return;
+
+        lvk::CSVLogger& logger = *m_DataLogger;
+
+        // On first log, add all the headers
+        if(!logger.has_started())
+        {
+            logger << "Job" << "Input" << "Output" << "Status"
+                   << "Frames" << "Time (s)" << "FPS" << "Error";
+            logger.next();
+        }
+
+        std::scoped_lock status_lock(m_StatusMutex);
+        for(size_t i = 0; i < m_Jobs.size(); i++)
+        {
+            auto& status = m_Jobs[i];
+            if(status.logged || (status.state != JobState::FINISHED && status.state != JobState::FAILED))
+                continue;
+
+            const double fps = status.elapsed.is_zero()
+                ? 0.0 : static_cast<double>(status.frames) / status.elapsed.seconds();
+
+            logger << i
+                   << status.job.input.string()
+                   << status.job.output.string()
+                   << (status.state == JobState::FINISHED ? "Finished" : "Failed")
+                   << status.frames
+                   << status.elapsed.seconds()
+                   << fps
+                   << status.error.value_or("");
+            logger.next();
+
+            status.logged = true;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,95 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <fstream>
+#include <atomic>
+#include <vector>
+#include <mutex>
+
+#include "VideoIOConfiguration.hpp"
+#include "VideoProcessor.hpp"
+#include "ConsoleLogger.hpp"
+
+namespace clt
+{
+
+    struct BatchJob
+    {
+        std::filesystem::path input, output;
+        std::optional<std::filesystem::path> profile;
+    };
+
+
+    // Runs the jobs of a batch manifest concurrently within one process, so that
+    // they share the OpenCL programs and a single worker thread budget, instead
+    // of each job compiling its own programs and oversubscribing the cores.
+    class BatchProcessor
+    {
+    public:
+
+        explicit BatchProcessor(VideoIOConfiguration configuration);
+
+        std::optional<std::string> run();
+
+        void stop();
+
+    private:
+
+        enum class JobState {QUEUED, RUNNING, FINISHED, FAILED};
+
+        struct JobStatus
+        {
+            BatchJob job;
+            JobState state = JobState::QUEUED;
+            std::shared_ptr<VideoProcessor> processor;
+            std::optional<std::string> error;
+            lvk::Stopwatch timer;
+            lvk::Time elapsed;
+            uint64_t frames = 0;
+            bool logged = false;
+        };
+
+        std::optional<std::string> load_manifest();
+
+        void run_worker();
+
+        void run_job(JobStatus& status);
+
+        void print_progress();
+
+        void log_finished_jobs();
+
+    private:
+        VideoIOConfiguration m_Configuration;
+
+        std::vector<JobStatus> m_Jobs;
+        std::atomic<size_t> m_NextJob = 0, m_ActiveWorkers = 0;
+        mutable std::mutex m_StatusMutex;
+        std::atomic<bool> m_Terminate = false;
+
+        ConsoleLogger m_ConsoleLogger;
+        std::ofstream m_DataLogStream;
+        std::optional<lvk::CSVLogger> m_DataLogger;
+        lvk::Stopwatch m_BatchTimer;
+    };
+
+}
@@ -27,21 +27,18 @@ namespace clt
 {
 //---------------------------------------------------------------------------------------------------------------------
 
-    ConsoleLogger::ConsoleLogger()
-        : lvk::Logger(std::cout)
+    ConsoleLogger::ConsoleLogger(std::ostream& target)
+        : lvk::Logger(target)
     {
 #ifdef WIN32
         // If we are in Windows, we need to put the console in virtual terminal mode
         // so that it is capable of understanding ANSI codes and is cross-platform.
-        auto handle = GetStdHandle(STD_OUTPUT_HANDLE);
+        auto handle = GetStdHandle(&target == &std::cerr ? STD_ERROR_HANDLE : STD_OUTPUT_HANDLE);
         SetConsoleMode(
             handle,
             ENABLE_PROCESSED_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING | DISABLE_NEWLINE_AUTO_RETURN
         );
 #endif
-
-        std::cout << "\033[?25l" // Disable cursor
-                  << "\033[=7l"; // Disable line wrapping (non-windows)
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -50,8 +47,11 @@ namespace clt
     {
         // TODO: restore windows console mode
 
-        std::cout << "\033[?25h" // Enable cursor
+        if(m_Started)
+        {
+            raw() << "\033[?25h" // Enable cursor
                   << "\033[=7h"; // Enable line wrapping (non-windows)
+        }
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -66,12 +66,21 @@ namespace clt
 
     void ConsoleLogger::clear()
     {
+        // NOTE: the console is only taken over once something is logged,
+        // so that unused loggers do not interfere with the console.
+        if(!m_Started)
+        {
+            raw() << "\033[?25l" // Disable cursor
+                  << "\033[=7l"; // Disable line wrapping (non-windows)
+            m_Started = true;
+        }
+
         if(m_LineCount > 0)
-            std::cout << "\033[" << (m_LineCount) << 'A'; // Move cursor up to beginning of log
+            raw() << "\033[" << (m_LineCount) << 'A'; // Move cursor up to beginning of log
 
 
-        std::cout << "\033[0G" // Move cursor to start of line
-                  << "\033[0J"; // Delete everything after and including the cursor
+        raw() << "\033[0G" // Move cursor to start of line
+              << "\033[0J"; // Delete everything after and including the cursor
 
         m_LineCount = 0;
     }
@@ -26,7 +26,7 @@ namespace clt
     {
     public:
 
-        ConsoleLogger();
+        explicit ConsoleLogger(std::ostream& target = std::cout);
 
         ~ConsoleLogger() noexcept override;
 
@@ -38,6 +38,7 @@ namespace clt
 
     private:
         size_t m_LineCount = 0;
+        bool m_Started = false;
     };
 
 }
@@ -0,0 +1,219 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "LibavSink.hpp"
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+}
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    LibavSink::~LibavSink()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> LibavSink::open(
+        const std::filesystem::path& path,
+        const int codec,
+        const double framerate,
+        const cv::Size& resolution
+    )
+    {
+        close();
+
+        const auto path_string = path.string();
+        avformat_alloc_output_context2(&m_FormatContext, nullptr, nullptr, path_string.c_str());
+        if(m_FormatContext == nullptr)
+            return cv::format("Failed to find a container format for \'%s\'", path_string.c_str());
+
+        // Map the fourcc to an encoder, falling back to the default of the container.
+        const AVCodec* encoder = nullptr;
+        if(codec != 0)
+        {
+            const AVCodecTag* const tags[] = {avformat_get_riff_video_tags(), avformat_get_mov_video_tags(), nullptr};
+            encoder = avcodec_find_encoder(av_codec_get_id(tags, static_cast<unsigned int>(codec)));
+        }
+        if(encoder == nullptr)
+            encoder = avcodec_find_encoder(m_FormatContext->oformat->video_codec);
+
+        if(encoder == nullptr)
+        {
+            release();
+            return cv::format("Failed to find a suitable encoder for \'%s\'", path_string.c_str());
+        }
+
+        const AVRational rate = av_d2q(framerate, 100000);
+
+        m_EncoderContext = avcodec_alloc_context3(encoder);
+        m_EncoderContext->width = resolution.width;
+        m_EncoderContext->height = resolution.height;
+        m_EncoderContext->pix_fmt = AV_PIX_FMT_YUV420P;
+
+        // NOTE: lvk YUV frames are full range BT.601, as from cv::cvtColor, so must be
+        // tagged as such, otherwise players decode them as limited range video.
+        m_EncoderContext->color_range = AVCOL_RANGE_JPEG;
+        m_EncoderContext->colorspace = AVCOL_SPC_BT470BG;
+        m_EncoderContext->color_primaries = AVCOL_PRI_BT709;
+        m_EncoderContext->color_trc = AVCOL_TRC_IEC61966_2_1;
+        m_EncoderContext->framerate = rate;
+        m_EncoderContext->time_base = av_inv_q(rate);
+        m_EncoderContext->thread_count = 0;
+        m_EncoderContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+        if(m_FormatContext->oformat->flags & AVFMT_GLOBALHEADER)
+            m_EncoderContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+        if(avcodec_open2(m_EncoderContext, encoder, nullptr) < 0)
+        {
+            release();
+            return cv::format("Failed to open the \'%s\' encoder", encoder->name);
+        }
+
+        m_Stream = avformat_new_stream(m_FormatContext, nullptr);
+        avcodec_parameters_from_context(m_Stream->codecpar, m_EncoderContext);
+        m_Stream->time_base = m_EncoderContext->time_base;
+
+        if(!(m_FormatContext->oformat->flags & AVFMT_NOFILE)
+            && avio_open(&m_FormatContext->pb, path_string.c_str(), AVIO_FLAG_WRITE) < 0)
+        {
+            release();
+            return cv::format("Failed to create an output stream at \'%s\'", path_string.c_str());
+        }
+
+        if(avformat_write_header(m_FormatContext, nullptr) < 0)
+        {
+            release();
+            return cv::format("Failed to write the header of \'%s\'", path_string.c_str());
+        }
+
+        m_Frame = av_frame_alloc();
+        m_Frame->format = AV_PIX_FMT_YUV420P;
+        m_Frame->color_range = m_EncoderContext->color_range;
+        m_Frame->colorspace = m_EncoderContext->colorspace;
+        m_Frame->color_primaries = m_EncoderContext->color_primaries;
+        m_Frame->color_trc = m_EncoderContext->color_trc;
+        m_Frame->width = resolution.width;
+        m_Frame->height = resolution.height;
+        av_frame_get_buffer(m_Frame, 0);
+
+        m_Packet = av_packet_alloc();
+        m_FrameIndex = 0;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LibavSink::write(const lvk::VideoFrame& frame)
+    {
+        LVK_ASSERT(frame.has_known_format());
+
+        if(!is_open() || av_frame_make_writable(m_Frame) < 0)
+            return false;
+
+        const cv::Size luma_size(m_Frame->width, m_Frame->height);
+        const cv::Size chroma_size((luma_size.width + 1) / 2, (luma_size.height + 1) / 2);
+        LVK_ASSERT(frame.size() == luma_size);
+
+        // Split the frame into planes, downscaling the chroma planes for 4:2:0.
+        frame.viewAsFormat(m_ConversionBuffer, lvk::VideoFrame::YUV);
+        cv::split(m_ConversionBuffer, m_Planes);
+        cv::resize(m_Planes[1], m_ChromaPlanes[0], chroma_size, 0, 0, cv::INTER_AREA);
+        cv::resize(m_Planes[2], m_ChromaPlanes[1], chroma_size, 0, 0, cv::INTER_AREA);
+
+        // Download the planes directly into the encoder frame.
+        m_Planes[0].copyTo(cv::Mat(luma_size, CV_8UC1, m_Frame->data[0], m_Frame->linesize[0]));
+        m_ChromaPlanes[0].copyTo(cv::Mat(chroma_size, CV_8UC1, m_Frame->data[1], m_Frame->linesize[1]));
+        m_ChromaPlanes[1].copyTo(cv::Mat(chroma_size, CV_8UC1, m_Frame->data[2], m_Frame->linesize[2]));
+
+        m_Frame->pts = m_FrameIndex++;
+        return encode(m_Frame);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LibavSink::encode(const AVFrame* frame)
+    {
+        if(avcodec_send_frame(m_EncoderContext, frame) < 0)
+            return false;
+
+        while(true)
+        {
+            const int result = avcodec_receive_packet(m_EncoderContext, m_Packet);
+            if(result == AVERROR(EAGAIN) || result == AVERROR_EOF)
+                return true;
+            else if(result < 0)
+                return false;
+
+            av_packet_rescale_ts(m_Packet, m_EncoderContext->time_base, m_Stream->time_base);
+            m_Packet->stream_index = m_Stream->index;
+
+            // NOTE: the muxer takes ownership of the packet data.
+            if(av_interleaved_write_frame(m_FormatContext, m_Packet) < 0)
+                return false;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LibavSink::is_open() const
+    {
+        return m_Frame != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void LibavSink::close()
+    {
+        if(is_open())
+        {
+            // Flush all frames still buffered in the encoder.
+            encode(nullptr);
+            av_write_trailer(m_FormatContext);
+        }
+        release();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void LibavSink::release()
+    {
+        av_frame_free(&m_Frame);
+        av_packet_free(&m_Packet);
+        avcodec_free_context(&m_EncoderContext);
+
+        if(m_FormatContext != nullptr)
+        {
+            if(!(m_FormatContext->oformat->flags & AVFMT_NOFILE))
+                avio_closep(&m_FormatContext->pb);
+
+            avformat_free_context(m_FormatContext);
+            m_FormatContext = nullptr;
+        }
+        m_Stream = nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,83 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+
+#include "VideoSink.hpp"
+
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVStream;
+struct AVPacket;
+struct AVFrame;
+
+namespace clt
+{
+
+    // NOTE: Encodes YUV frames directly with libavcodec as YUV420P, mirroring
+    // the LibavSource. Frames of other formats are converted to YUV first.
+    class LibavSink final : public VideoSink
+    {
+    public:
+
+        LibavSink() = default;
+
+        LibavSink(const LibavSink&) = delete;
+
+        ~LibavSink() override;
+
+
+        // NOTE: a codec of zero, or one unknown to libav, uses the container default.
+        std::optional<std::string> open(
+            const std::filesystem::path& path,
+            const int codec,
+            const double framerate,
+            const cv::Size& resolution
+        );
+
+        bool write(const lvk::VideoFrame& frame) override;
+
+        bool is_open() const override;
+
+        void close() override;
+
+
+        LibavSink& operator=(const LibavSink&) = delete;
+
+    private:
+
+        bool encode(const AVFrame* frame);
+
+        void release();
+
+    private:
+        AVFormatContext* m_FormatContext = nullptr;
+        AVCodecContext* m_EncoderContext = nullptr;
+        AVStream* m_Stream = nullptr;
+        AVPacket* m_Packet = nullptr;
+        AVFrame* m_Frame = nullptr;
+        int64_t m_FrameIndex = 0;
+
+        lvk::VideoFrame m_ConversionBuffer;
+        std::vector<cv::UMat> m_Planes;
+        cv::UMat m_ChromaPlanes[2];
+    };
+
+}
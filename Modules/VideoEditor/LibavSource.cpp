@@ -0,0 +1,404 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "LibavSource.hpp"
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace clt
+{
+    // Scaling from the limited 'video' range of [16, 235] luma and [16, 240] chroma, to the full range.
+    constexpr double LUMA_RANGE_SCALE = 255.0 / 219.0;
+    constexpr double CHROMA_RANGE_SCALE = 255.0 / 224.0;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Formats whose planes can be handed to LVK without any colour conversion.
+    static bool is_supported(const AVPixelFormat format)
+    {
+        switch(format)
+        {
+            case AV_PIX_FMT_YUV420P:
+            case AV_PIX_FMT_YUVJ420P:
+            case AV_PIX_FMT_YUV422P:
+            case AV_PIX_FMT_YUVJ422P:
+            case AV_PIX_FMT_YUV444P:
+            case AV_PIX_FMT_YUVJ444P:
+            case AV_PIX_FMT_NV12:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Whether the planes use the full 8bit range, as LVK's YUV frames do, rather than the
+    // limited 'video' range. NOTE: untagged videos are limited unless the format says otherwise.
+    static bool is_full_range(const AVFrame* frame)
+    {
+        switch(static_cast<AVPixelFormat>(frame->format))
+        {
+            case AV_PIX_FMT_YUVJ420P:
+            case AV_PIX_FMT_YUVJ422P:
+            case AV_PIX_FMT_YUVJ444P:
+                return true;
+            default:
+                return frame->color_range == AVCOL_RANGE_JPEG;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    LibavSource::~LibavSource()
+    {
+        release();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> LibavSource::open(const std::filesystem::path& path)
+    {
+        release();
+
+        const auto path_string = path.string();
+        if(avformat_open_input(&m_FormatContext, path_string.c_str(), nullptr, nullptr) < 0)
+            return cv::format("Failed to open the input video \'%s\'", path_string.c_str());
+
+        if(avformat_find_stream_info(m_FormatContext, nullptr) < 0)
+        {
+            release();
+            return cv::format("Failed to find the streams of the input video \'%s\'", path_string.c_str());
+        }
+
+        const AVCodec* decoder = nullptr;
+        m_StreamIndex = av_find_best_stream(m_FormatContext, AVMEDIA_TYPE_VIDEO, -1, -1, &decoder, 0);
+        if(m_StreamIndex < 0 || decoder == nullptr)
+        {
+            release();
+            return cv::format("Failed to find a decodable video stream in \'%s\'", path_string.c_str());
+        }
+
+        m_DecoderContext = avcodec_alloc_context3(decoder);
+        avcodec_parameters_to_context(m_DecoderContext, m_FormatContext->streams[m_StreamIndex]->codecpar);
+
+        // Let the decoder decode multiple frames in parallel.
+        m_DecoderContext->thread_count = 0;
+        m_DecoderContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+        if(avcodec_open2(m_DecoderContext, decoder, nullptr) < 0)
+        {
+            release();
+            return cv::format("Failed to open the \'%s\' decoder", decoder->name);
+        }
+
+        if(m_DecoderContext->pix_fmt != AV_PIX_FMT_NONE && !is_supported(m_DecoderContext->pix_fmt))
+        {
+            const auto format_name = av_get_pix_fmt_name(m_DecoderContext->pix_fmt);
+            release();
+            return cv::format(
+                "Unsupported libav pixel format \'%s\', use the OpenCV backend instead",
+                format_name != nullptr ? format_name : "unknown"
+            );
+        }
+
+        m_Packet = av_packet_alloc();
+        m_Frame = av_frame_alloc();
+        m_Draining = false;
+        m_FramePending = false;
+        m_FrameNumber = 0;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LibavSource::read(lvk::VideoFrame& frame)
+    {
+        if(!is_open())
+            return false;
+
+        // NOTE: seeking leaves the target frame decoded, ready to be read.
+        if(!m_FramePending && !decode_next())
+            return false;
+        m_FramePending = false;
+
+        if(!upload_frame(frame))
+            return false;
+
+        m_FrameNumber++;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LibavSource::seek(const uint64_t frame_number)
+    {
+        if(!is_open())
+            return false;
+
+        const AVRational rate = frame_rate();
+        if(rate.num <= 0 || rate.den <= 0)
+            return false;
+
+        const auto stream = m_FormatContext->streams[m_StreamIndex];
+        const int64_t start_time = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+        const int64_t frame_duration = av_rescale_q(1, av_inv_q(rate), stream->time_base);
+        const int64_t target_pts = start_time + av_rescale_q(
+            static_cast<int64_t>(frame_number), av_inv_q(rate), stream->time_base
+        );
+
+        // Seek to the nearest keyframe preceding the target.
+        if(av_seek_frame(m_FormatContext, m_StreamIndex, target_pts, AVSEEK_FLAG_BACKWARD) < 0)
+            return false;
+
+        avcodec_flush_buffers(m_DecoderContext);
+        m_Draining = false;
+
+        // Decode and discard all frames up to the target, without uploading them.
+        // NOTE: frames within half a frame of the target are considered the target.
+        // Frames without a timestamp are assumed to directly follow the last frame.
+        int64_t frame_pts = AV_NOPTS_VALUE;
+        bool rewound = false;
+        do
+        {
+            if(!decode_next())
+            {
+                m_FramePending = false;
+                return false;
+            }
+
+            if(m_Frame->best_effort_timestamp != AV_NOPTS_VALUE)
+                frame_pts = m_Frame->best_effort_timestamp;
+            else if(frame_pts != AV_NOPTS_VALUE)
+                frame_pts += frame_duration;
+            else if(rewound)
+                frame_pts = start_time;
+            else
+            {
+                // The keyframe we landed on has no timestamp, so its position is unknown.
+                // Rewind to the start of the stream, where the frames can be counted instead.
+                if(av_seek_frame(m_FormatContext, m_StreamIndex, start_time, AVSEEK_FLAG_BACKWARD) < 0)
+                {
+                    m_FramePending = false;
+                    return false;
+                }
+
+                avcodec_flush_buffers(m_DecoderContext);
+                m_Draining = false;
+                rewound = true;
+            }
+        }
+        while(frame_pts == AV_NOPTS_VALUE || frame_pts < target_pts - frame_duration / 2);
+
+        m_FramePending = true;
+        m_FrameNumber = frame_number;
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LibavSource::decode_next()
+    {
+        while(true)
+        {
+            const int result = avcodec_receive_frame(m_DecoderContext, m_Frame);
+            if(result == 0)
+                return true;
+            else if(result != AVERROR(EAGAIN) || m_Draining)
+                return false;
+
+            // The decoder needs more packets, so feed it the next packet of our stream.
+            // Once the file is exhausted, drain the remaining frames from the decoder.
+            if(av_read_frame(m_FormatContext, m_Packet) < 0)
+            {
+                avcodec_send_packet(m_DecoderContext, nullptr);
+                m_Draining = true;
+                continue;
+            }
+
+            if(m_Packet->stream_index == m_StreamIndex)
+                avcodec_send_packet(m_DecoderContext, m_Packet);
+
+            av_packet_unref(m_Packet);
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LibavSource::upload_frame(lvk::VideoFrame& frame)
+    {
+        const auto format = static_cast<AVPixelFormat>(m_Frame->format);
+        if(!is_supported(format))
+            return false;
+
+        const cv::Size luma_size(m_Frame->width, m_Frame->height);
+        const auto descriptor = av_pix_fmt_desc_get(format);
+        const cv::Size chroma_size(
+            AV_CEIL_RSHIFT(m_Frame->width, descriptor->log2_chroma_w),
+            AV_CEIL_RSHIFT(m_Frame->height, descriptor->log2_chroma_h)
+        );
+        const bool subsampled = chroma_size != luma_size;
+
+        // Upload the planes, then interleave them into a single YUV frame.
+        // Subsampled chroma planes are upscaled to match the luma plane.
+        cv::Mat(luma_size, CV_8UC1, m_Frame->data[0], m_Frame->linesize[0]).copyTo(m_LumaPlane);
+
+        // Limited range planes are expanded to full range, which is what LVK expects.
+        // NOTE: this is done before the chroma upscaling, to process as few pixels as possible.
+        const bool expand_range = !is_full_range(m_Frame);
+        if(expand_range)
+            m_LumaPlane.convertTo(m_LumaPlane, CV_8U, LUMA_RANGE_SCALE, -16.0 * LUMA_RANGE_SCALE);
+
+        frame.create(luma_size, CV_8UC3);
+        std::vector<cv::UMat> dst_planes = {frame};
+        if(format == AV_PIX_FMT_NV12)
+        {
+            // NOTE: NV12 has a single interleaved UV plane, which is always subsampled.
+            cv::Mat(chroma_size, CV_8UC2, m_Frame->data[1], m_Frame->linesize[1]).copyTo(m_ChromaUploads[0]);
+            if(expand_range)
+                m_ChromaUploads[0].convertTo(m_ChromaUploads[0], CV_8U, CHROMA_RANGE_SCALE, 128.0 * (1.0 - CHROMA_RANGE_SCALE));
+
+            cv::resize(m_ChromaUploads[0], m_ChromaPlanes[0], luma_size, 0, 0, cv::INTER_LINEAR);
+
+            const int from_to[] = {0, 0, 1, 1, 2, 2};
+            cv::mixChannels(std::vector<cv::UMat>{m_LumaPlane, m_ChromaPlanes[0]}, dst_planes, from_to, 3);
+        }
+        else
+        {
+            std::vector<cv::UMat> src_planes = {m_LumaPlane};
+            for(int i = 0; i < 2; i++)
+            {
+                cv::Mat(chroma_size, CV_8UC1, m_Frame->data[i + 1], m_Frame->linesize[i + 1]).copyTo(m_ChromaUploads[i]);
+                if(expand_range)
+                    m_ChromaUploads[i].convertTo(m_ChromaUploads[i], CV_8U, CHROMA_RANGE_SCALE, 128.0 * (1.0 - CHROMA_RANGE_SCALE));
+
+                if(subsampled)
+                {
+                    cv::resize(m_ChromaUploads[i], m_ChromaPlanes[i], luma_size, 0, 0, cv::INTER_LINEAR);
+                    src_planes.push_back(m_ChromaPlanes[i]);
+                }
+                else src_planes.push_back(m_ChromaUploads[i]);
+            }
+
+            const int from_to[] = {0, 0, 1, 1, 2, 2};
+            cv::mixChannels(src_planes, dst_planes, from_to, 3);
+        }
+        frame.format = lvk::VideoFrame::YUV;
+
+        // Set the frame timestamp relative to the start of the stream, if known.
+        const auto stream = m_FormatContext->streams[m_StreamIndex];
+        const int64_t start_time = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+        const int64_t pts = m_Frame->best_effort_timestamp;
+        const double seconds = pts == AV_NOPTS_VALUE ? 0.0 : static_cast<double>(pts - start_time) * av_q2d(stream->time_base);
+        frame.timestamp = static_cast<uint64_t>(lvk::Time::Seconds(std::max(seconds, 0.0)).nanoseconds());
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool LibavSource::is_open() const
+    {
+        return m_DecoderContext != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Size LibavSource::resolution() const
+    {
+        if(!is_open())
+            return {0, 0};
+
+        return {m_DecoderContext->width, m_DecoderContext->height};
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double LibavSource::framerate() const
+    {
+        if(!is_open())
+            return 0.0;
+
+        const auto rate = frame_rate();
+        return rate.den > 0 ? av_q2d(rate) : 0.0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    AVRational LibavSource::frame_rate() const
+    {
+        LVK_ASSERT(is_open());
+
+        const auto stream = m_FormatContext->streams[m_StreamIndex];
+        return stream->avg_frame_rate.num > 0 ? stream->avg_frame_rate : stream->r_frame_rate;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int LibavSource::codec() const
+    {
+        if(!is_open())
+            return 0;
+
+        return static_cast<int>(m_FormatContext->streams[m_StreamIndex]->codecpar->codec_tag);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t LibavSource::frame_count() const
+    {
+        if(!is_open())
+            return 0;
+
+        const auto stream = m_FormatContext->streams[m_StreamIndex];
+        if(stream->nb_frames > 0)
+            return static_cast<uint64_t>(stream->nb_frames);
+
+        // Otherwise estimate it from the duration of the video.
+        if(m_FormatContext->duration == AV_NOPTS_VALUE)
+            return 0;
+
+        const double duration = static_cast<double>(m_FormatContext->duration) / AV_TIME_BASE;
+        return static_cast<uint64_t>(duration * framerate());
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t LibavSource::frame_number() const
+    {
+        return m_FrameNumber;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void LibavSource::release()
+    {
+        av_frame_free(&m_Frame);
+        av_packet_free(&m_Packet);
+        avcodec_free_context(&m_DecoderContext);
+        avformat_close_input(&m_FormatContext);
+        m_StreamIndex = -1;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
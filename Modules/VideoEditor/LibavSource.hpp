@@ -0,0 +1,97 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+
+#include "VideoSource.hpp"
+
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVPacket;
+struct AVFrame;
+struct AVRational;
+
+namespace clt
+{
+
+    // NOTE: Decodes videos directly with libavcodec, handing the decoded planes
+    // to LVK as YUV frames. This skips the BGR conversion of cv::VideoCapture,
+    // which the filters would otherwise just convert back to YUV. Limited range
+    // planes are expanded to the full range of LVK's YUV frames on upload.
+    class LibavSource final : public VideoSource
+    {
+    public:
+
+        LibavSource() = default;
+
+        LibavSource(const LibavSource&) = delete;
+
+        ~LibavSource() override;
+
+
+        std::optional<std::string> open(const std::filesystem::path& path);
+
+
+        bool read(lvk::VideoFrame& frame) override;
+
+        bool seek(const uint64_t frame_number) override;
+
+        bool is_open() const override;
+
+
+        cv::Size resolution() const override;
+
+        double framerate() const override;
+
+        int codec() const override;
+
+
+        uint64_t frame_count() const override;
+
+        uint64_t frame_number() const override;
+
+
+        LibavSource& operator=(const LibavSource&) = delete;
+
+    private:
+
+        bool decode_next();
+
+        AVRational frame_rate() const;
+
+        bool upload_frame(lvk::VideoFrame& frame);
+
+        void release();
+
+    private:
+        AVFormatContext* m_FormatContext = nullptr;
+        AVCodecContext* m_DecoderContext = nullptr;
+        AVPacket* m_Packet = nullptr;
+        AVFrame* m_Frame = nullptr;
+
+        int m_StreamIndex = -1;
+        bool m_Draining = false;
+        bool m_FramePending = false;
+        uint64_t m_FrameNumber = 0;
+
+        cv::UMat m_LumaPlane, m_ChromaUploads[2], m_ChromaPlanes[2];
+    };
+
+}
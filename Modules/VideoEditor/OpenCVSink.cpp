@@ -0,0 +1,85 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "OpenCVSink.hpp"
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> OpenCVSink::open(
+        const std::filesystem::path& path,
+        const int codec,
+        const double framerate,
+        const cv::Size& resolution
+    )
+    {
+        try {
+            std::vector<int> properties = {
+                cv::VideoWriterProperties::VIDEOWRITER_PROP_HW_ACCELERATION, 1,
+                cv::VideoWriterProperties::VIDEOWRITER_PROP_HW_ACCELERATION_USE_OPENCL, 1
+            };
+
+            m_Writer = cv::VideoWriter(path.string(), cv::CAP_FFMPEG, codec, framerate, resolution, properties);
+        }
+        catch(std::exception& e)
+        {
+            return cv::format(
+                "Failed to create output stream with error \'%s\'",
+                e.what()
+            );
+        }
+
+        // If stream is still not opened, then creation failed
+        if(!m_Writer.isOpened())
+            return cv::format("Failed to create an output stream at \'%s\'", path.string().c_str());
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool OpenCVSink::write(const lvk::VideoFrame& frame)
+    {
+        LVK_ASSERT(frame.has_known_format());
+
+        if(frame.format != lvk::VideoFrame::BGR)
+        {
+            frame.reformatTo(m_ConversionBuffer, lvk::VideoFrame::BGR);
+            m_Writer.write(m_ConversionBuffer);
+        }
+        else m_Writer.write(frame);
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool OpenCVSink::is_open() const
+    {
+        return m_Writer.isOpened();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void OpenCVSink::close()
+    {
+        m_Writer.release();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
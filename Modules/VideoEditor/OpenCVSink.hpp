@@ -0,0 +1,51 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+
+#include "VideoSink.hpp"
+
+namespace clt
+{
+
+    // NOTE: cv::VideoWriter only accepts BGR frames.
+    class OpenCVSink final : public VideoSink
+    {
+    public:
+
+        std::optional<std::string> open(
+            const std::filesystem::path& path,
+            const int codec,
+            const double framerate,
+            const cv::Size& resolution
+        );
+
+        bool write(const lvk::VideoFrame& frame) override;
+
+        bool is_open() const override;
+
+        void close() override;
+
+    private:
+        cv::VideoWriter m_Writer;
+        lvk::VideoFrame m_ConversionBuffer;
+    };
+
+}
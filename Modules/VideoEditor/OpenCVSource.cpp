@@ -0,0 +1,129 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "OpenCVSource.hpp"
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> OpenCVSource::open(const std::filesystem::path& path)
+    {
+        std::vector<int> properties = {
+            cv::CAP_PROP_HW_ACCELERATION, 1,
+            cv::CAP_PROP_HW_ACCELERATION_USE_OPENCL, 1
+        };
+
+        m_DeviceCapture = false;
+        m_Capture = cv::VideoCapture(path.string(), cv::CAP_FFMPEG, properties);
+        if(!m_Capture.isOpened())
+            return cv::format("Failed to open the input video \'%s\'", path.string().c_str());
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> OpenCVSource::open(const uint32_t device)
+    {
+        m_DeviceCapture = true;
+        m_Capture = cv::VideoCapture(device);
+        if(!m_Capture.isOpened())
+            return cv::format("Failed to capture device \'%u\'", device);
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool OpenCVSource::read(lvk::VideoFrame& frame)
+    {
+        if(!m_Capture.read(frame))
+            return false;
+
+        frame.format = lvk::VideoFrame::BGR;
+
+        // Set frame timestamp if supported, otherwise set it to zero.
+        const auto stream_position = std::max(0.0, m_Capture.get(cv::CAP_PROP_POS_MSEC));
+        frame.timestamp = static_cast<uint64_t>(lvk::Time::Milliseconds(stream_position).nanoseconds());
+
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool OpenCVSource::seek(const uint64_t frame_number)
+    {
+        if(m_DeviceCapture)
+            return false;
+
+        // NOTE: the FFMPEG backend seeks to the preceding keyframe and decodes up to the frame.
+        return m_Capture.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(frame_number));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool OpenCVSource::is_open() const
+    {
+        return m_Capture.isOpened();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Size OpenCVSource::resolution() const
+    {
+        return {
+            static_cast<int>(m_Capture.get(cv::CAP_PROP_FRAME_WIDTH)),
+            static_cast<int>(m_Capture.get(cv::CAP_PROP_FRAME_HEIGHT))
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double OpenCVSource::framerate() const
+    {
+        return std::max(m_Capture.get(cv::CAP_PROP_FPS), 0.0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int OpenCVSource::codec() const
+    {
+        return static_cast<int>(m_Capture.get(cv::CAP_PROP_FOURCC));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t OpenCVSource::frame_count() const
+    {
+        // NOTE: The frame count is not valid for device capture streams
+        if(m_DeviceCapture)
+            return 0;
+
+        return static_cast<uint64_t>(std::max(m_Capture.get(cv::CAP_PROP_FRAME_COUNT), 0.0));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t OpenCVSource::frame_number() const
+    {
+        // NOTE: CAP_PROP_POS_FRAMES may not be supported by the backend.
+        return static_cast<uint64_t>(std::max(m_Capture.get(cv::CAP_PROP_POS_FRAMES), 0.0));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
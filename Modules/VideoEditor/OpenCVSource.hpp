@@ -0,0 +1,61 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+
+#include "VideoSource.hpp"
+
+namespace clt
+{
+
+    // NOTE: cv::VideoCapture always decodes frames to BGR.
+    class OpenCVSource final : public VideoSource
+    {
+    public:
+
+        std::optional<std::string> open(const std::filesystem::path& path);
+
+        std::optional<std::string> open(const uint32_t device);
+
+
+        bool read(lvk::VideoFrame& frame) override;
+
+        bool seek(const uint64_t frame_number) override;
+
+        bool is_open() const override;
+
+
+        cv::Size resolution() const override;
+
+        double framerate() const override;
+
+        int codec() const override;
+
+
+        uint64_t frame_count() const override;
+
+        uint64_t frame_number() const override;
+
+    private:
+        cv::VideoCapture m_Capture;
+        bool m_DeviceCapture = false;
+    };
+
+}
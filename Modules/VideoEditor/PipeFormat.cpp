@@ -0,0 +1,131 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "PipeFormat.hpp"
+
+#ifdef WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr size_t PIPE_BUFFER_SIZE = 8 * 1024 * 1024;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool is_standard_stream(const std::filesystem::path& path)
+    {
+        return path == "-";
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void prepare_pipe(FILE* stream)
+    {
+        LVK_ASSERT(stream != nullptr);
+
+#ifdef WIN32
+        // Windows opens the standard streams in text mode, which mangles frame data.
+        _setmode(_fileno(stream), _O_BINARY);
+#endif
+
+        std::setvbuf(stream, nullptr, _IOFBF, PIPE_BUFFER_SIZE);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<PixelLayout> parse_pixel_layout(const std::string& name)
+    {
+        if(name == "yuv420p") return PixelLayout::YUV420P;
+        if(name == "yuv422p") return PixelLayout::YUV422P;
+        if(name == "yuv444p") return PixelLayout::YUV444P;
+        if(name == "gray")    return PixelLayout::GRAY;
+        if(name == "bgr24")   return PixelLayout::BGR24;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<PixelLayout> parse_y4m_colorspace(const std::string& colorspace)
+    {
+        // NOTE: the 4:2:0 variants only differ in chroma siting, which we ignore.
+        if(colorspace == "420" || colorspace == "420jpeg" || colorspace == "420paldv" || colorspace == "420mpeg2")
+            return PixelLayout::YUV420P;
+        if(colorspace == "422") return PixelLayout::YUV422P;
+        if(colorspace == "444") return PixelLayout::YUV444P;
+        if(colorspace == "mono") return PixelLayout::GRAY;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    const char* y4m_colorspace(const PixelLayout layout)
+    {
+        switch(layout)
+        {
+            case PixelLayout::YUV420P: return "420jpeg";
+            case PixelLayout::YUV422P: return "422";
+            case PixelLayout::YUV444P: return "444";
+            case PixelLayout::GRAY:    return "mono";
+            default:                   return nullptr;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int plane_count(const PixelLayout layout)
+    {
+        return (layout == PixelLayout::GRAY || layout == PixelLayout::BGR24) ? 1 : 3;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Size plane_size(const PixelLayout layout, const cv::Size& resolution, const int plane)
+    {
+        LVK_ASSERT_RANGE(plane, 0, plane_count(layout) - 1);
+
+        if(plane == 0) return resolution;
+
+        switch(layout)
+        {
+            case PixelLayout::YUV420P: return {(resolution.width + 1) / 2, (resolution.height + 1) / 2};
+            case PixelLayout::YUV422P: return {(resolution.width + 1) / 2, resolution.height};
+            default:                   return resolution;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    size_t frame_bytes(const PixelLayout layout, const cv::Size& resolution)
+    {
+        if(layout == PixelLayout::BGR24)
+            return 3 * resolution.area();
+
+        size_t bytes = 0;
+        for(int p = 0; p < plane_count(layout); p++)
+            bytes += plane_size(layout, resolution, p).area();
+
+        return bytes;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,60 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <filesystem>
+#include <optional>
+#include <cstdio>
+
+namespace clt
+{
+
+    // Planar layouts of the frames carried over a pipe, matching the ffmpeg pixel formats.
+    enum class PixelLayout
+    {
+        YUV420P,
+        YUV422P,
+        YUV444P,
+        GRAY,
+        BGR24
+    };
+
+    // The path used to select stdin or stdout as a video target.
+    bool is_standard_stream(const std::filesystem::path& path);
+
+    // Puts the stream into binary mode and gives it a large I/O buffer.
+    // NOTE: must be called before any other operation on the stream.
+    void prepare_pipe(FILE* stream);
+
+
+    std::optional<PixelLayout> parse_pixel_layout(const std::string& name);
+
+    std::optional<PixelLayout> parse_y4m_colorspace(const std::string& colorspace);
+
+    // NOTE: returns nullptr for layouts that Y4M does not support.
+    const char* y4m_colorspace(const PixelLayout layout);
+
+
+    int plane_count(const PixelLayout layout);
+
+    cv::Size plane_size(const PixelLayout layout, const cv::Size& resolution, const int plane);
+
+    size_t frame_bytes(const PixelLayout layout, const cv::Size& resolution);
+
+}
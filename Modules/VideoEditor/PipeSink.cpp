@@ -0,0 +1,157 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "PipeSink.hpp"
+
+#include <numeric>
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr int Y4M_FRAMERATE_PRECISION = 1000;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    PipeSink::~PipeSink()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> PipeSink::open(
+        const bool y4m,
+        const PixelLayout layout,
+        const double framerate,
+        const cv::Size& resolution
+    )
+    {
+        LVK_ASSERT(resolution.width > 0 && resolution.height > 0);
+        LVK_ASSERT(framerate > 0.0);
+
+        close();
+
+        const char* colorspace = y4m_colorspace(layout);
+        if(y4m && colorspace == nullptr)
+            return "The output pixel layout is not supported by Y4M, use --raw instead";
+
+        m_Stream = stdout;
+        m_Y4M = y4m;
+        m_Layout = layout;
+        m_Resolution = resolution;
+        prepare_pipe(m_Stream);
+
+        m_FrameBuffer.create(1, static_cast<int>(frame_bytes(m_Layout, m_Resolution)), CV_8UC1);
+
+        if(m_Y4M)
+        {
+            // Express the framerate as a reduced fraction, as required by Y4M.
+            const int denominator = Y4M_FRAMERATE_PRECISION;
+            const int numerator = static_cast<int>(std::round(framerate * denominator));
+            const int divisor = std::gcd(numerator, denominator);
+
+            // NOTE: lvk YUV frames are full range, so must be flagged as such for the reader.
+            const auto header = cv::format(
+                "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C%s XCOLORRANGE=FULL\n",
+                m_Resolution.width,
+                m_Resolution.height,
+                numerator / divisor,
+                denominator / divisor,
+                colorspace
+            );
+
+            if(std::fputs(header.c_str(), m_Stream) < 0)
+            {
+                m_Stream = nullptr;
+                return "Failed to write the Y4M header to stdout";
+            }
+        }
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PipeSink::write(const lvk::VideoFrame& frame)
+    {
+        LVK_ASSERT(frame.has_known_format());
+
+        if(!is_open())
+            return false;
+
+        LVK_ASSERT(frame.size() == m_Resolution);
+
+        // Download the planes directly into the frame buffer.
+        uint8_t* data = m_FrameBuffer.data;
+        if(m_Layout == PixelLayout::BGR24)
+        {
+            frame.viewAsFormat(m_ConversionBuffer, lvk::VideoFrame::BGR);
+            m_ConversionBuffer.copyTo(cv::Mat(m_Resolution, CV_8UC3, data));
+        }
+        else if(m_Layout == PixelLayout::GRAY)
+        {
+            frame.viewAsFormat(m_ConversionBuffer, lvk::VideoFrame::GRAY);
+            m_ConversionBuffer.copyTo(cv::Mat(m_Resolution, CV_8UC1, data));
+        }
+        else
+        {
+            // Split the frame into planes, downscaling any subsampled chroma planes.
+            frame.viewAsFormat(m_ConversionBuffer, lvk::VideoFrame::YUV);
+            cv::split(m_ConversionBuffer, m_Planes);
+
+            for(int p = 0; p < 3; p++)
+            {
+                const cv::Size size = plane_size(m_Layout, m_Resolution, p);
+                if(p > 0 && size != m_Resolution)
+                {
+                    cv::resize(m_Planes[p], m_ChromaPlanes[p - 1], size, 0, 0, cv::INTER_AREA);
+                    m_ChromaPlanes[p - 1].copyTo(cv::Mat(size, CV_8UC1, data));
+                }
+                else m_Planes[p].copyTo(cv::Mat(size, CV_8UC1, data));
+
+                data += size.area();
+            }
+        }
+
+        if(m_Y4M && std::fputs("FRAME\n", m_Stream) < 0)
+            return false;
+
+        // NOTE: the frame is written in one large request, which bypasses the stdio buffer.
+        return std::fwrite(m_FrameBuffer.data, 1, m_FrameBuffer.total(), m_Stream) == m_FrameBuffer.total();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PipeSink::is_open() const
+    {
+        return m_Stream != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PipeSink::close()
+    {
+        if(is_open())
+        {
+            std::fflush(m_Stream);
+            m_Stream = nullptr;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,69 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <optional>
+
+#include "VideoSink.hpp"
+#include "PipeFormat.hpp"
+
+namespace clt
+{
+
+    // NOTE: Writes Y4M or raw frames to stdout, mirroring the PipeSource.
+    // Frames are converted to the layout of the pipe if necessary.
+    class PipeSink final : public VideoSink
+    {
+    public:
+
+        PipeSink() = default;
+
+        PipeSink(const PipeSink&) = delete;
+
+        ~PipeSink() override;
+
+
+        std::optional<std::string> open(
+            const bool y4m,
+            const PixelLayout layout,
+            const double framerate,
+            const cv::Size& resolution
+        );
+
+        bool write(const lvk::VideoFrame& frame) override;
+
+        bool is_open() const override;
+
+        void close() override;
+
+
+        PipeSink& operator=(const PipeSink&) = delete;
+
+    private:
+        FILE* m_Stream = nullptr;
+        bool m_Y4M = false;
+
+        PixelLayout m_Layout = PixelLayout::YUV420P;
+        cv::Size m_Resolution;
+
+        cv::Mat m_FrameBuffer;
+        lvk::VideoFrame m_ConversionBuffer;
+        cv::UMat m_Planes[3], m_ChromaPlanes[2];
+    };
+
+}
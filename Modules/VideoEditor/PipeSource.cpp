@@ -0,0 +1,448 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "PipeSource.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    constexpr size_t PARSE_BUFFER_FRAMES = 4;
+    constexpr size_t MAX_Y4M_LINE_LENGTH = 1024;
+    constexpr const char* Y4M_SIGNATURE = "YUV4MPEG2";
+    constexpr const char* Y4M_FRAME_SIGNATURE = "FRAME";
+
+    // Scaling from the limited 'video' range of [16, 235] luma and [16, 240] chroma, to the full range.
+    constexpr double LUMA_RANGE_SCALE = 255.0 / 219.0;
+    constexpr double CHROMA_RANGE_SCALE = 255.0 / 224.0;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Reads a newline terminated Y4M header line, without the newline.
+    static bool read_line(FILE* stream, std::string& line)
+    {
+        line.clear();
+        for(int c = std::fgetc(stream); c != '\n'; c = std::fgetc(stream))
+        {
+            if(c == EOF || line.size() >= MAX_Y4M_LINE_LENGTH)
+                return false;
+
+            line.push_back(static_cast<char>(c));
+        }
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    PipeSource::~PipeSource()
+    {
+        release();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> PipeSource::open()
+    {
+        release();
+
+        m_Stream = stdin;
+        m_Y4M = true;
+        prepare_pipe(m_Stream);
+
+        if(auto error = parse_header(); error.has_value())
+        {
+            m_Stream = nullptr;
+            return error;
+        }
+
+        start_parser();
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> PipeSource::open(const PixelLayout layout, const cv::Size& resolution, const double framerate)
+    {
+        LVK_ASSERT(resolution.width > 0 && resolution.height > 0);
+        LVK_ASSERT(framerate > 0.0);
+
+        release();
+
+        m_Stream = stdin;
+        m_Y4M = false;
+        prepare_pipe(m_Stream);
+
+        m_Layout = layout;
+        m_LimitedRange = false;
+        m_Resolution = resolution;
+        m_Framerate = framerate;
+
+        start_parser();
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> PipeSource::parse_header()
+    {
+        std::string header;
+        if(!read_line(m_Stream, header))
+            return "Failed to read the Y4M header from stdin";
+
+        std::stringstream header_stream(header);
+        std::string token;
+
+        header_stream >> token;
+        if(token != Y4M_SIGNATURE)
+            return "Input from stdin is not a Y4M stream, use --raw to read raw frames";
+
+        // Defaults as per the Y4M specification
+        // NOTE: streams without a colour range are assumed to be full range.
+        m_Layout = PixelLayout::YUV420P;
+        m_LimitedRange = false;
+        m_Resolution = {0, 0};
+        m_Framerate = 0.0;
+
+        while(header_stream >> token)
+        {
+            const auto value = token.substr(1);
+            try
+            {
+                switch(token[0])
+                {
+                    case 'W':
+                        m_Resolution.width = std::stoi(value);
+                        break;
+                    case 'H':
+                        m_Resolution.height = std::stoi(value);
+                        break;
+                    case 'F':
+                    {
+                        const auto separator = value.find(':');
+                        if(separator != std::string::npos)
+                        {
+                            const double numerator = std::stod(value.substr(0, separator));
+                            const double denominator = std::stod(value.substr(separator + 1));
+                            m_Framerate = denominator > 0 ? numerator / denominator : 0.0;
+                        }
+                        break;
+                    }
+                    case 'C':
+                    {
+                        const auto layout = parse_y4m_colorspace(value);
+                        if(!layout.has_value())
+                            return cv::format("Unsupported Y4M colorspace \'%s\'", value.c_str());
+
+                        m_Layout = *layout;
+                        break;
+                    }
+                    case 'X':
+                        if(value == "COLORRANGE=LIMITED")
+                            m_LimitedRange = true;
+                        else if(value == "COLORRANGE=FULL")
+                            m_LimitedRange = false;
+                        break;
+                    default:
+                        // NOTE: interlacing, aspect ratio and other extensions are ignored.
+                        break;
+                }
+            }
+            catch(const std::invalid_argument&)
+            {
+                return cv::format("Malformed Y4M header parameter \'%s\'", token.c_str());
+            }
+            catch(const std::out_of_range&)
+            {
+                return cv::format("Malformed Y4M header parameter \'%s\'", token.c_str());
+            }
+        }
+
+        if(m_Resolution.width <= 0 || m_Resolution.height <= 0)
+            return "The Y4M header is missing the frame size";
+
+        if(m_Framerate <= 0.0)
+            return "The Y4M header is missing the framerate";
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PipeSource::start_parser()
+    {
+        const auto buffer_size = static_cast<int>(frame_bytes(m_Layout, m_Resolution));
+
+        m_FreeBuffers.clear();
+        for(size_t i = 0; i < PARSE_BUFFER_FRAMES; i++)
+            m_FreeBuffers.emplace_back(1, buffer_size, CV_8UC1);
+
+        m_EndOfStream = false;
+        m_Terminate = false;
+        m_FrameNumber = 0;
+
+        m_ParserThread.emplace(&PipeSource::run_parser, this);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PipeSource::run_parser()
+    {
+        lvk::Trace::set_thread_name("Pipe Parser");
+
+        cv::Mat buffer;
+        while(!m_Terminate)
+        {
+            // Grab a free buffer, waiting if the reader has fallen behind.
+            {
+                std::unique_lock<std::mutex> buffer_lock(m_BufferMutex);
+                while(m_FreeBuffers.empty() && !m_Terminate)
+                    m_FreeFlag.wait(buffer_lock);
+
+                if(m_Terminate) break;
+
+                buffer = std::move(m_FreeBuffers.back());
+                m_FreeBuffers.pop_back();
+            }
+
+            LVK_TRACE_CATEGORY("Parse Frame", "stream");
+            if(!parse_frame(buffer))
+                break;
+
+            std::scoped_lock buffer_lock(m_BufferMutex);
+            m_ParsedBuffers.push(std::move(buffer));
+            m_ParsedFlag.notify_one();
+        }
+
+        std::scoped_lock buffer_lock(m_BufferMutex);
+        m_EndOfStream = true;
+        m_ParsedFlag.notify_one();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PipeSource::parse_frame(cv::Mat& buffer)
+    {
+        if(m_Y4M)
+        {
+            // Each frame is prefixed by its own header, whose parameters we ignore.
+            std::string header;
+            if(!read_line(m_Stream, header) || !header.starts_with(Y4M_FRAME_SIGNATURE))
+                return false;
+        }
+
+        // NOTE: the frame is read in one large request, which bypasses the stdio buffer.
+        const size_t bytes = buffer.total();
+        return std::fread(buffer.data, 1, bytes, m_Stream) == bytes;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PipeSource::read(lvk::VideoFrame& frame)
+    {
+        cv::Mat buffer;
+        if(!is_open() || !next_buffer(buffer))
+            return false;
+
+        upload_frame(buffer, frame);
+        frame.timestamp = static_cast<uint64_t>(
+            lvk::Time::Seconds(static_cast<double>(m_FrameNumber) / m_Framerate).nanoseconds()
+        );
+        m_FrameNumber++;
+
+        // Hand the buffer back to the parser once its contents have been uploaded.
+        recycle_buffer(std::move(buffer));
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PipeSource::seek(const uint64_t frame_number)
+    {
+        // NOTE: pipes can only be seeked forwards, by discarding frames.
+        if(!is_open() || frame_number < m_FrameNumber)
+            return false;
+
+        cv::Mat buffer;
+        while(m_FrameNumber < frame_number)
+        {
+            if(!next_buffer(buffer))
+                return false;
+
+            recycle_buffer(std::move(buffer));
+            m_FrameNumber++;
+        }
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PipeSource::next_buffer(cv::Mat& buffer)
+    {
+        std::unique_lock<std::mutex> buffer_lock(m_BufferMutex);
+        while(m_ParsedBuffers.empty())
+        {
+            if(m_EndOfStream) return false;
+            m_ParsedFlag.wait(buffer_lock);
+        }
+
+        buffer = std::move(m_ParsedBuffers.front());
+        m_ParsedBuffers.pop();
+        return true;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PipeSource::recycle_buffer(cv::Mat&& buffer)
+    {
+        std::scoped_lock buffer_lock(m_BufferMutex);
+        m_FreeBuffers.push_back(std::move(buffer));
+        m_FreeFlag.notify_one();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PipeSource::upload_frame(const cv::Mat& buffer, lvk::VideoFrame& frame)
+    {
+        uint8_t* data = buffer.data;
+        if(m_Layout == PixelLayout::BGR24)
+        {
+            cv::Mat(m_Resolution, CV_8UC3, data).copyTo(frame);
+            frame.format = lvk::VideoFrame::BGR;
+            return;
+        }
+
+        if(m_Layout == PixelLayout::GRAY)
+        {
+            cv::Mat(m_Resolution, CV_8UC1, data).copyTo(frame);
+            if(m_LimitedRange)
+                frame.convertTo(frame, CV_8U, LUMA_RANGE_SCALE, -16.0 * LUMA_RANGE_SCALE);
+
+            frame.format = lvk::VideoFrame::GRAY;
+            return;
+        }
+
+        // Upload the planes, then interleave them into a single YUV frame.
+        // Subsampled chroma planes are upscaled to match the luma plane.
+        std::vector<cv::UMat> src_planes;
+        for(int p = 0; p < 3; p++)
+        {
+            const cv::Size size = plane_size(m_Layout, m_Resolution, p);
+            cv::Mat(size, CV_8UC1, data).copyTo(m_Planes[p]);
+            data += size.area();
+
+            // Limited range planes are expanded before any upscaling, to process fewer pixels.
+            if(m_LimitedRange)
+            {
+                if(p == 0)
+                    m_Planes[p].convertTo(m_Planes[p], CV_8U, LUMA_RANGE_SCALE, -16.0 * LUMA_RANGE_SCALE);
+                else
+                    m_Planes[p].convertTo(m_Planes[p], CV_8U, CHROMA_RANGE_SCALE, 128.0 * (1.0 - CHROMA_RANGE_SCALE));
+            }
+
+            if(p > 0 && size != m_Resolution)
+            {
+                cv::resize(m_Planes[p], m_ChromaPlanes[p - 1], m_Resolution, 0, 0, cv::INTER_LINEAR);
+                src_planes.push_back(m_ChromaPlanes[p - 1]);
+            }
+            else src_planes.push_back(m_Planes[p]);
+        }
+
+        frame.create(m_Resolution, CV_8UC3);
+        std::vector<cv::UMat> dst_planes = {frame};
+
+        const int from_to[] = {0, 0, 1, 1, 2, 2};
+        cv::mixChannels(src_planes, dst_planes, from_to, 3);
+        frame.format = lvk::VideoFrame::YUV;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PipeSource::is_open() const
+    {
+        return m_Stream != nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    cv::Size PipeSource::resolution() const
+    {
+        return is_open() ? m_Resolution : cv::Size(0, 0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    double PipeSource::framerate() const
+    {
+        return is_open() ? m_Framerate : 0.0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    int PipeSource::codec() const
+    {
+        return 0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t PipeSource::frame_count() const
+    {
+        // NOTE: the length of a pipe is never known in advance.
+        return 0;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t PipeSource::frame_number() const
+    {
+        return m_FrameNumber;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    PixelLayout PipeSource::layout() const
+    {
+        return m_Layout;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PipeSource::release()
+    {
+        if(m_ParserThread.has_value())
+        {
+            // NOTE: the parser may still be blocked reading stdin,
+            // in which case we must wait for the writer to catch up.
+            {
+                std::scoped_lock buffer_lock(m_BufferMutex);
+                m_Terminate = true;
+                m_FreeFlag.notify_one();
+            }
+            m_ParserThread->join();
+            m_ParserThread.reset();
+        }
+
+        m_FreeBuffers.clear();
+        m_ParsedBuffers = {};
+        m_Stream = nullptr;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,119 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <condition_variable>
+#include <optional>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <queue>
+#include <mutex>
+
+#include "VideoSource.hpp"
+#include "PipeFormat.hpp"
+
+namespace clt
+{
+
+    // NOTE: Reads Y4M or raw frames from stdin, so that LVK can sit in a shell pipe
+    // without any container or codec overhead. Frames are read and parsed on their
+    // own thread, which keeps a few frames buffered ahead of the filters. Y4M streams
+    // flagged as limited range are expanded to the full range of LVK's YUV frames.
+    class PipeSource final : public VideoSource
+    {
+    public:
+
+        PipeSource() = default;
+
+        PipeSource(const PipeSource&) = delete;
+
+        ~PipeSource() override;
+
+
+        // Reads a Y4M stream, whose header declares the frame geometry.
+        std::optional<std::string> open();
+
+        // Reads raw frames of the given geometry, with no header or framing.
+        std::optional<std::string> open(const PixelLayout layout, const cv::Size& resolution, const double framerate);
+
+
+        bool read(lvk::VideoFrame& frame) override;
+
+        bool seek(const uint64_t frame_number) override;
+
+        bool is_open() const override;
+
+
+        cv::Size resolution() const override;
+
+        double framerate() const override;
+
+        int codec() const override;
+
+
+        uint64_t frame_count() const override;
+
+        uint64_t frame_number() const override;
+
+
+        PixelLayout layout() const;
+
+
+        PipeSource& operator=(const PipeSource&) = delete;
+
+    private:
+
+        std::optional<std::string> parse_header();
+
+        void start_parser();
+
+        void run_parser();
+
+        bool parse_frame(cv::Mat& buffer);
+
+        bool next_buffer(cv::Mat& buffer);
+
+        void recycle_buffer(cv::Mat&& buffer);
+
+        void upload_frame(const cv::Mat& buffer, lvk::VideoFrame& frame);
+
+        void release();
+
+    private:
+        FILE* m_Stream = nullptr;
+        bool m_Y4M = false;
+
+        PixelLayout m_Layout = PixelLayout::YUV420P;
+        bool m_LimitedRange = false;
+        cv::Size m_Resolution;
+        double m_Framerate = 0.0;
+        uint64_t m_FrameNumber = 0;
+
+        std::optional<std::thread> m_ParserThread;
+        std::vector<cv::Mat> m_FreeBuffers;
+        std::queue<cv::Mat> m_ParsedBuffers;
+        std::condition_variable m_ParsedFlag, m_FreeFlag;
+        std::mutex m_BufferMutex;
+        bool m_EndOfStream = false;
+        std::atomic<bool> m_Terminate = false;
+
+        cv::UMat m_Planes[3], m_ChromaPlanes[2];
+    };
+
+}
@@ -0,0 +1,177 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#include "PreviewWindow.hpp"
+
+#include <chrono>
+
+namespace clt
+{
+//---------------------------------------------------------------------------------------------------------------------
+
+    // NOTE: the window must be polled regularly to stay responsive.
+    constexpr auto WINDOW_POLL_PERIOD = std::chrono::milliseconds(15);
+    constexpr int ESCAPE_KEY = 27;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Returns the largest size with the aspect ratio of the frame that fits within the bounds.
+    static cv::Size fit_within(const cv::Size& frame_size, const cv::Size& bounds)
+    {
+        const double scale = std::min({
+            static_cast<double>(bounds.width) / frame_size.width,
+            static_cast<double>(bounds.height) / frame_size.height,
+            1.0
+        });
+
+        return {
+            std::max(static_cast<int>(frame_size.width * scale), 1),
+            std::max(static_cast<int>(frame_size.height * scale), 1)
+        };
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    PreviewWindow::PreviewWindow(std::string name, const cv::Size& initial_size)
+        : m_Name(std::move(name)),
+          m_InitialSize(initial_size)
+    {
+        LVK_ASSERT(initial_size.width > 0 && initial_size.height > 0);
+
+        m_RenderThread.emplace(&PreviewWindow::run_renderer, this);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    PreviewWindow::~PreviewWindow()
+    {
+        close();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PreviewWindow::show(const lvk::VideoFrame& frame)
+    {
+        LVK_ASSERT(frame.has_known_format());
+
+        // Replace any frame that has not been rendered yet.
+        // NOTE: this is a shallow copy, the frame's data is shared with the caller.
+        std::scoped_lock frame_lock(m_FrameMutex);
+        m_PendingFrame = frame;
+        m_FrameFlag.notify_one();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool PreviewWindow::is_open() const
+    {
+        return m_Open;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PreviewWindow::close()
+    {
+        if(m_RenderThread.has_value())
+        {
+            {
+                std::scoped_lock frame_lock(m_FrameMutex);
+                m_Terminate = true;
+                m_FrameFlag.notify_one();
+            }
+            m_RenderThread->join();
+            m_RenderThread.reset();
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PreviewWindow::run_renderer()
+    {
+        lvk::Trace::set_thread_name("Preview");
+
+        // NOTE: the window must be created, used and destroyed on the same thread.
+        cv::namedWindow(m_Name, cv::WINDOW_NORMAL | cv::WINDOW_KEEPRATIO);
+
+        lvk::VideoFrame frame;
+        while(!m_Terminate)
+        {
+            // Wait for a new frame, polling the window while we wait.
+            {
+                std::unique_lock<std::mutex> frame_lock(m_FrameMutex);
+                m_FrameFlag.wait_for(frame_lock, WINDOW_POLL_PERIOD, [&](){
+                    return m_PendingFrame.has_value() || m_Terminate;
+                });
+
+                if(m_PendingFrame.has_value())
+                {
+                    frame = std::move(*m_PendingFrame);
+                    m_PendingFrame.reset();
+                }
+            }
+
+            if(!frame.empty())
+            {
+                render(frame);
+                frame.release();
+            }
+
+            // Close the window if escape is pressed, note
+            // that polling is also required to update it.
+            if(cv::pollKey() == ESCAPE_KEY)
+                break;
+        }
+
+        m_Open = false;
+        cv::destroyWindow(m_Name);
+        cv::pollKey();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void PreviewWindow::render(const lvk::VideoFrame& frame)
+    {
+        LVK_TRACE_CATEGORY("Render Preview", "stream");
+
+        // Start with a window that fits on screen, rather than one matching the frame.
+        if(!m_Resized)
+        {
+            const auto window_size = fit_within(frame.size(), m_InitialSize);
+            cv::resizeWindow(m_Name, window_size.width, window_size.height);
+            m_Resized = true;
+        }
+
+        // Downscale the frame to the window before converting it to BGR for display,
+        // so that only the pixels which will actually be seen are processed.
+        auto window_size = cv::getWindowImageRect(m_Name).size();
+        if(window_size.width <= 0 || window_size.height <= 0)
+            window_size = m_InitialSize;
+
+        const auto preview_size = fit_within(frame.size(), window_size);
+        if(preview_size != frame.size())
+        {
+            cv::resize(frame, m_ScaledFrame, preview_size, 0, 0, cv::INTER_LINEAR);
+            m_ScaledFrame.format = frame.format;
+            m_ScaledFrame.viewAsFormat(m_DisplayFrame, lvk::VideoFrame::BGR);
+        }
+        else frame.viewAsFormat(m_DisplayFrame, lvk::VideoFrame::BGR);
+
+        cv::imshow(m_Name, m_DisplayFrame);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+}
@@ -0,0 +1,79 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+#include <condition_variable>
+#include <optional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+namespace clt
+{
+
+    // NOTE: Renders frames to a window on its own thread, which owns the window.
+    // Only the latest frame is shown, any frame not yet rendered is dropped, so
+    // the preview never holds back the caller. Frames are downscaled to the size
+    // of the window before being converted and shown.
+    class PreviewWindow
+    {
+    public:
+
+        inline static const cv::Size DefaultSize = {1280, 720};
+
+
+        explicit PreviewWindow(std::string name, const cv::Size& initial_size = DefaultSize);
+
+        PreviewWindow(const PreviewWindow&) = delete;
+
+        ~PreviewWindow();
+
+
+        // NOTE: frames are previewed by reference and must not be modified after being shown.
+        void show(const lvk::VideoFrame& frame);
+
+        // Returns false once the window has been closed by pressing escape.
+        bool is_open() const;
+
+        void close();
+
+
+        PreviewWindow& operator=(const PreviewWindow&) = delete;
+
+    private:
+
+        void run_renderer();
+
+        void render(const lvk::VideoFrame& frame);
+
+    private:
+        const std::string m_Name;
+        const cv::Size m_InitialSize;
+
+        std::optional<std::thread> m_RenderThread;
+        std::optional<lvk::VideoFrame> m_PendingFrame;
+        std::condition_variable m_FrameFlag;
+        std::mutex m_FrameMutex;
+        std::atomic<bool> m_Open = true, m_Terminate = false;
+
+        bool m_Resized = false;
+        lvk::VideoFrame m_ScaledFrame, m_DisplayFrame;
+    };
+
+}
@@ -23,6 +23,57 @@
 namespace clt
 {
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Parses a frame number such as '120f', or a time such as '90', '1:30' or '00:01:30.5'.
+    static std::optional<StreamPosition> parse_position(const std::string& position)
+    {
+        if(position.empty())
+            return std::nullopt;
+
+        try
+        {
+            size_t parsed_length = 0;
+            if(position.back() == 'f')
+            {
+                const auto frame = std::stoull(position, &parsed_length);
+                if(parsed_length != position.size() - 1)
+                    return std::nullopt;
+
+                return StreamPosition(static_cast<uint64_t>(frame));
+            }
+
+            // Accumulate each colon separated field of the time in seconds.
+            double seconds = 0.0;
+            std::stringstream time_stream(position);
+            for(std::string field; std::getline(time_stream, field, ':');)
+            {
+                const double value = std::stod(field, &parsed_length);
+                if(parsed_length != field.size() || value < 0.0)
+                    return std::nullopt;
+
+                seconds = 60.0 * seconds + value;
+            }
+            return lvk::Time::Seconds(seconds);
+        }
+        catch(const std::exception&)
+        {
+            return std::nullopt;
+        }
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    // Parses a positive size given as WxH, such as '1920x1080'.
+    static std::optional<cv::Size> parse_size(const std::string& size)
+    {
+        int width = 0, height = 0;
+        if(std::sscanf(size.c_str(), "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0)
+            return std::nullopt;
+
+        return cv::Size(width, height);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     VideoIOConfiguration::VideoIOConfiguration()
@@ -58,6 +109,13 @@ namespace clt
         for(int i = 1; i < argc; i++)
             arguments.emplace_back(argv[i]);
 
+        return from_arguments(std::move(arguments));
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoIOConfiguration::from_arguments(ArgQueue arguments)
+    {
         // Command-line format includes a mandatory input and optional output target
         // declaration, sandwiched between two sets of optional arguments.
 
@@ -65,8 +123,12 @@ namespace clt
         if(m_ParserError.has_value())
             return m_ParserError;
 
-        if(auto error = parse_io_targets(arguments); error.has_value())
-            return error;
+        // NOTE: batch manifests declare the inputs and outputs of each job.
+        if(!batch_manifest.has_value())
+        {
+            if(auto error = parse_io_targets(arguments); error.has_value())
+                return error;
+        }
 
         while(m_OptionParser.try_parse(arguments));
         if(m_ParserError.has_value())
@@ -97,7 +159,12 @@ namespace clt
 
         // Parse the input target
         std::optional<std::string> input_format;
-        if(std::filesystem::path path = input; path.has_filename() && path.has_extension())
+        if(is_standard_stream(input))
+        {
+            // Input is piped through stdin
+            input_source = std::filesystem::path(input);
+        }
+        else if(std::filesystem::path path = input; path.has_filename() && path.has_extension())
         {
             // Input is file path
             input_source = path;
@@ -111,7 +178,7 @@ namespace clt
         {
             // No input specified
             return cv::format(
-                "Unknown input, got \'%s\', expected a file path or integer device specifier",
+                "Unknown input, got \'%s\', expected a file path, integer device specifier or \'-\'",
                 input.c_str()
             );
         }
@@ -122,7 +189,13 @@ namespace clt
             // Attempt to parse an output, this is optional so it can safely fail.
             // The output will always be a file path with the same format as the input video
             auto output = std::string(arguments.front());
-            if(std::filesystem::path path = output; path.has_filename() && path.has_extension())
+            if(is_standard_stream(output))
+            {
+                // Output is piped through stdout
+                output_target = output;
+                arguments.pop_front();
+            }
+            else if(std::filesystem::path path = output; path.has_filename() && path.has_extension())
             {
                 // If the input was a video file, restrict the output to match the file format.
                 // This is not an encoding tool, so we can make things easier on ourselves here.
@@ -207,6 +280,8 @@ namespace clt
                      "device to read from.\n"
                   << "\t * Output is an optional video file path to which filtered video data is written. If paired "
                      "with a video file input, they must be of matching extensions. \n"
+                  << "\t * Either may be '-' to pipe Y4M video through stdin or stdout, or raw frames if --raw is "
+                     "used. The console output is moved to stderr when piping to stdout.\n"
                   << "\t * If no output is specified, or a device capture input is used, a display window will be used"
                      " to show output frames. This window can be closed using <escape>, ending all processing."
                   << "\n\n";
@@ -327,6 +402,95 @@ namespace clt
             }
         );
 
+        m_OptionParser.add_switch(
+            "--libav",
+            "Decodes and encodes video files natively with libav, passing YUV frames directly "
+            "to and from the filters instead of converting them to BGR. Not used for device captures.",
+            &use_libav
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--encoder-buffer",
+            "Used to specify how many frames can be queued for the encoder, which runs on its own thread. "
+            "Set to zero to encode synchronously on the output thread.",
+            [this](const int frames) {
+                if(frames < 0)
+                {
+                    m_ParserError = cv::format(
+                        "Encoder buffer cannot be negative, got \'%d\' frames",
+                        frames
+                    );
+                    return;
+                }
+                encoder_buffer_frames = static_cast<size_t>(frames);
+            }
+        );
+
+        m_OptionParser.add_variable<double>(
+            "--latency",
+            "Used to specify the real-time latency budget in milliseconds. Frames which cannot be filtered "
+            "within the budget are dropped, rather than letting the output fall behind the input. Device "
+            "captures are always processed in real-time, with a default budget of 100ms.",
+            [this](const double milliseconds) {
+                if(milliseconds <= 0.0)
+                {
+                    m_ParserError = cv::format(
+                        "Latency budget must be positive, got '%.2f' ms",
+                        milliseconds
+                    );
+                    return;
+                }
+                latency_budget = lvk::Time::Milliseconds(milliseconds);
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--start",
+            "Used to specify where processing starts in the input video, either as a time such as 90, 1:30 or "
+            "00:01:30.5, or as a frame number such as 2700f. Stabilizers are primed with the frames before it.",
+            [this](const std::string& position)
+            {
+                start_position = parse_position(position);
+                if(!start_position.has_value())
+                    m_ParserError = cv::format("Invalid start position, got \'%s\'", position.c_str());
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--end",
+            "Used to specify where processing ends in the input video, in the same format as --start. "
+            "The frame at the end position is not processed.",
+            [this](const std::string& position)
+            {
+                end_position = parse_position(position);
+                if(!end_position.has_value())
+                    m_ParserError = cv::format("Invalid end position, got \'%s\'", position.c_str());
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--raw",
+            "Pipes raw frames of the given pixel format through stdin and stdout instead of Y4M. "
+            "Supported formats are yuv420p, yuv422p, yuv444p, gray and bgr24.",
+            [this](const std::string& name)
+            {
+                raw_layout = parse_pixel_layout(name);
+                if(!raw_layout.has_value())
+                    m_ParserError = cv::format("Unknown raw pixel format, got \'%s\'", name.c_str());
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--raw-size",
+            "Used to declare the WxH resolution of raw frames piped through stdin, e.g. 1920x1080.",
+            [this](const std::string& size)
+            {
+                raw_resolution = parse_size(size);
+                if(!raw_resolution.has_value())
+                    m_ParserError = cv::format("Invalid raw frame size, got \'%s\', expected WxH", size.c_str());
+            }
+        );
+
         m_OptionParser.add_switch(
             "-C",
             "Lists the fourcc codes of all available encoders.",
@@ -402,6 +566,123 @@ namespace clt
                 log_target = path;
             }
         );
+
+        m_OptionParser.add_variable<std::string>(
+            "--trace",
+            "Records a trace of the processing pipeline to the specified JSON filepath. "
+            "The trace can be inspected using chrome://tracing or the Perfetto UI.",
+            [this](const std::string& path_arg)
+            {
+                const std::filesystem::path path = path_arg;
+                if(path.extension() != ".json")
+                {
+                    m_ParserError = cv::format(
+                        "Invalid trace target, got file type %s, expected '.json'",
+                        path.extension().string().c_str()
+                    );
+                }
+                trace_target = path;
+            }
+        );
+
+        m_OptionParser.add_variable<std::string>(
+            "--batch",
+            "Runs all the jobs in the specified manifest file concurrently, in place of an input and output. "
+            "Each line of the manifest declares a job as \'input output [profile]\', where the optional profile "
+            "is loaded as with -p. Use -L to log the results of each job.",
+            [this](const std::string& path_arg)
+            {
+                const std::filesystem::path path = path_arg;
+                if(!std::filesystem::exists(path))
+                {
+                    m_ParserError = cv::format("Batch manifest \'%s\' does not exist", path_arg.c_str());
+                    return;
+                }
+                batch_manifest = path;
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--jobs",
+            "Used to specify how many batch jobs are run at once. Defaults to a quarter of the thread budget.",
+            [this](const int jobs) {
+                if(jobs <= 0)
+                {
+                    m_ParserError = cv::format("Batch jobs must be positive, got \'%d\' jobs", jobs);
+                    return;
+                }
+                batch_jobs = static_cast<uint32_t>(jobs);
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--threads",
+            "Used to specify the number of worker threads shared by all filters. Defaults to all cores.",
+            [this](const int threads) {
+                if(threads <= 0)
+                {
+                    m_ParserError = cv::format("Thread budget must be positive, got \'%d\' threads", threads);
+                    return;
+                }
+                thread_budget = static_cast<uint32_t>(threads);
+            }
+        );
+
+        m_OptionParser.add_switch(
+            "--tune-opencl",
+            "Tunes the OpenCL work group sizes for the current device at the input resolution before processing. "
+            "The results are stored and used by all future runs on the same device.",
+            &tune_opencl
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--bench",
+            "Benchmarks the filter chain by predecoding the given number of frames and filtering them repeatedly, "
+            "without any output or display. A JSON report of the filter throughput is written to stdout.",
+            [this](const int frames) {
+                if(frames <= 0)
+                {
+                    m_ParserError = cv::format(
+                        "Benchmark frames must be positive, got \'%d\' frames",
+                        frames
+                    );
+                    return;
+                }
+                bench_frames = static_cast<uint32_t>(frames);
+            }
+        );
+
+        m_OptionParser.add_variable<double>(
+            "--bench-time",
+            "Used to specify the numeric amount of seconds to run the benchmark for. Defaults to 10 seconds.",
+            [this](const double seconds) {
+                if(seconds <= 0)
+                {
+                    m_ParserError = cv::format(
+                        "Benchmark time cannot be zero or negative, got \'%.2f\' seconds",
+                        seconds
+                    );
+                    return;
+                }
+                bench_duration = lvk::Time::Seconds(seconds);
+            }
+        );
+
+        m_OptionParser.add_variable<int>(
+            "--bench-passes",
+            "Used to run the benchmark for a fixed number of passes over the frames, instead of a fixed time.",
+            [this](const int passes) {
+                if(passes <= 0)
+                {
+                    m_ParserError = cv::format(
+                        "Benchmark passes must be positive, got \'%d\' passes",
+                        passes
+                    );
+                    return;
+                }
+                bench_passes = static_cast<uint32_t>(passes);
+            }
+        );
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -412,7 +693,7 @@ namespace clt
         m_FilterParser.add_filter<lvk::StabilizationFilter, lvk::StabilizationFilterSettings>(
             {"vs", "stab"},
             "A video stabilization filter used to smoothen percieved camera motions.",
-            [](clt::OptionsParser& config_parser, lvk::StabilizationFilterSettings& config){
+            [this](clt::OptionsParser& config_parser, lvk::StabilizationFilterSettings& config){
                 config_parser.add_variable<float>(
                     {".crop_prop", ".cp"},
                     "Used to set percentage crop and movement area allowed for stabilization",
@@ -431,6 +712,53 @@ namespace clt
                     "The amount of camera smoothing to apply to the video.",
                     &config.predictive_samples
                 );
+                config_parser.add_variable<std::string>(
+                    {".detection_res", ".dr"},
+                    "The WxH resolution at which features are detected and tracked.",
+                    [&](const std::string& size){
+                        if(const auto resolution = parse_size(size); resolution.has_value())
+                            config.detection_resolution = *resolution;
+                        else
+                            m_ParserError = cv::format("Invalid detection resolution, got \'%s\'", size.c_str());
+                    }
+                );
+                config_parser.add_variable<std::string>(
+                    {".regions", ".rg"},
+                    "The WxH grid of regions over which features are evenly detected.",
+                    [&](const std::string& size){
+                        if(const auto regions = parse_size(size); regions.has_value())
+                            config.detection_regions = *regions;
+                        else
+                            m_ParserError = cv::format("Invalid detection regions, got \'%s\'", size.c_str());
+                    }
+                );
+                config_parser.add_variable<std::string>(
+                    {".motion_res", ".mr"},
+                    "The WxH resolution of the motion mesh, local motions are only tracked above 2x2.",
+                    [&](const std::string& size){
+                        const auto resolution = parse_size(size);
+                        if(!resolution.has_value() || resolution->width < 2 || resolution->height < 2)
+                        {
+                            m_ParserError = cv::format("Invalid motion resolution, got \'%s\'", size.c_str());
+                            return;
+                        }
+                        config.motion_resolution = *resolution;
+                        config.track_local_motions = *resolution != lvk::WarpMesh::MinimumSize;
+                    }
+                );
+                config_parser.add_variable(
+                    {".motion_samples", ".ms"},
+                    "The minimum number of tracked features needed to estimate the motion.",
+                    &config.min_motion_samples
+                );
+                config_parser.add_variable<float>(
+                    {".budget", ".b"},
+                    "Enables the adaptive quality governor, which lowers the tracking quality whenever "
+                    "the filter takes longer than the given frame time budget in milliseconds.",
+                    [&](auto budget){
+                        config.frame_time_budget = lvk::Time::Milliseconds(budget);
+                    }
+                );
             }
         );
 
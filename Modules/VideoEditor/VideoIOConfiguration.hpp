@@ -25,14 +25,19 @@
 
 #include "OptionParser.hpp"
 #include "FilterParser.hpp"
+#include "PipeFormat.hpp"
 
 namespace clt
 {
 
+    // A position in the input, given either as a time or a frame number.
+    using StreamPosition = std::variant<lvk::Time, uint64_t>;
+
     struct VideoIOConfiguration
     {
         // Input / Process Settings
         std::variant<std::monostate, std::filesystem::path, uint32_t> input_source;
+        std::optional<StreamPosition> start_position, end_position;
         std::vector<std::shared_ptr<lvk::VideoFilter>> filter_chain;
 
         // Output Settings
@@ -40,6 +45,21 @@ namespace clt
         std::optional<double> output_framerate;
         std::optional<int> output_codec;
 
+        // NOTE: uses libav directly, rather than through OpenCV.
+        bool use_libav = false;
+
+        // NOTE: zero disables the asynchronous encoder.
+        size_t encoder_buffer_frames = 8;
+
+        // NOTE: only used when piping to or from the standard streams,
+        // which otherwise carry Y4M, whose header declares the geometry.
+        std::optional<PixelLayout> raw_layout;
+        std::optional<cv::Size> raw_resolution;
+
+        // NOTE: real-time streams drop late frames instead of falling behind the input.
+        // Device captures are always streamed in real-time, other inputs only when given a budget.
+        std::optional<lvk::Time> latency_budget;
+
         bool render_output = false;
         std::optional<lvk::Time> render_period;
 
@@ -47,6 +67,18 @@ namespace clt
         bool print_progress = true;
         bool print_timings = false;
         std::optional<std::filesystem::path> log_target;
+        std::optional<std::filesystem::path> trace_target;
+        bool tune_opencl = false;
+
+        // NOTE: benchmarks run for the given number of passes, otherwise for the duration.
+        std::optional<uint32_t> bench_frames;
+        std::optional<uint32_t> bench_passes;
+        lvk::Time bench_duration = lvk::Time::Seconds(10);
+
+        // NOTE: the jobs of a batch run concurrently, sharing the thread budget.
+        std::optional<std::filesystem::path> batch_manifest;
+        std::optional<uint32_t> batch_jobs;
+        std::optional<uint32_t> thread_budget;
 
         lvk::Time update_period = lvk::Time::Seconds(0.5);
 
@@ -56,6 +88,8 @@ namespace clt
 
         std::optional<std::string> from_command_line(const int argc, char* argv[]);
 
+        std::optional<std::string> from_arguments(ArgQueue arguments);
+
         void print_filter_manual(const std::string& filter) const;
 
         void print_manual() const;
@@ -17,6 +17,18 @@
 
 #include "VideoProcessor.hpp"
 
+#include "OpenCVSource.hpp"
+#include "OpenCVSink.hpp"
+#include "PipeSource.hpp"
+#include "PipeSink.hpp"
+#ifdef LVK_HAS_LIBAV
+#include "LibavSource.hpp"
+#include "LibavSink.hpp"
+#endif
+
+#include <opencv2/core/ocl.hpp>
+#include <iostream>
+#include <numeric>
 #include <type_traits>
 #include <utility>
 
@@ -26,11 +38,15 @@ namespace clt
 
     constexpr size_t FILTER_TIMING_SAMPLES = 300;
     constexpr const char* RENDER_WINDOW_NAME = "LVK Output";
+    constexpr double DEFAULT_RAW_FRAMERATE = 30.0;
+    constexpr size_t REAL_TIME_BUFFER_FRAMES = 2;
+    constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
 
 //---------------------------------------------------------------------------------------------------------------------
 
     VideoProcessor::VideoProcessor(VideoIOConfiguration configuration)
-        : m_Configuration(std::move(configuration))
+        : m_Configuration(std::move(configuration)),
+          m_ConsoleLogger((is_piped_output() || m_Configuration.bench_frames.has_value()) ? std::cerr : std::cout)
     {}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -44,22 +60,51 @@ namespace clt
 
             if constexpr(std::is_same_v<source_type, std::filesystem::path>)
             {
-                std::vector<int> properties = {
-                    cv::CAP_PROP_HW_ACCELERATION, 1,
-                    cv::CAP_PROP_HW_ACCELERATION_USE_OPENCL, 1
-                };
-
                 m_DeviceCapture = false;
-                m_InputStream = cv::VideoCapture(source.string(), cv::CAP_FFMPEG, properties);
-                if(!m_InputStream.isOpened())
-                    input_error = cv::format("Failed to open the input video \'%s\'", source.string().c_str());
+                if(is_standard_stream(source))
+                {
+                    auto stream = std::make_unique<PipeSource>();
+                    if(m_Configuration.raw_layout.has_value())
+                    {
+                        if(m_Configuration.raw_resolution.has_value())
+                        {
+                            input_error = stream->open(
+                                *m_Configuration.raw_layout,
+                                *m_Configuration.raw_resolution,
+                                m_Configuration.output_framerate.value_or(DEFAULT_RAW_FRAMERATE)
+                            );
+                        }
+                        else input_error = "Raw frames piped through stdin must have their size declared with --raw-size";
+                    }
+                    else input_error = stream->open();
+
+                    m_PipeLayout = stream->layout();
+                    m_InputStream = std::move(stream);
+                }
+                else if(m_Configuration.use_libav)
+                {
+#ifdef LVK_HAS_LIBAV
+                    auto stream = std::make_unique<LibavSource>();
+                    input_error = stream->open(source);
+                    m_InputStream = std::move(stream);
+#else
+                    input_error = "The libav backend is not available in this build";
+#endif
+                }
+                else
+                {
+                    auto stream = std::make_unique<OpenCVSource>();
+                    input_error = stream->open(source);
+                    m_InputStream = std::move(stream);
+                }
             }
             else if constexpr(std::is_same_v<source_type, uint32_t>)
             {
                 m_DeviceCapture = true;
-                m_InputStream = cv::VideoCapture(source);
-                if(!m_InputStream.isOpened())
-                    input_error = cv::format("Failed to capture device \'%u\'", source);
+
+                auto stream = std::make_unique<OpenCVSource>();
+                input_error = stream->open(source);
+                m_InputStream = std::move(stream);
             }
             else input_error = "No input source was specified!";
         },
@@ -87,6 +132,81 @@ namespace clt
             m_DataLogger.emplace(m_DataLogStream);
         }
 
+        // NOTE: the length of device captures and pipes is never known.
+        const uint64_t frame_count = m_DeviceCapture ? 0 : m_InputStream->frame_count();
+        m_ReadCount = frame_count;
+
+        return initialize_trimming();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoProcessor::initialize_trimming()
+    {
+        if(!m_Configuration.start_position.has_value() && !m_Configuration.end_position.has_value())
+            return std::nullopt;
+
+        if(m_DeviceCapture)
+            return "Device captures cannot be trimmed";
+
+        // Resolve the positions into frame numbers
+        const double framerate = m_InputStream->framerate();
+        std::optional<std::string> position_error;
+        const auto to_frame_number = [&](const StreamPosition& position) -> uint64_t {
+            if(const auto time = std::get_if<lvk::Time>(&position); time != nullptr)
+            {
+                if(framerate <= 0.0)
+                    position_error = "The input framerate is unknown, so positions must be given as frame numbers";
+
+                return static_cast<uint64_t>(std::llround(time->seconds() * framerate));
+            }
+            return std::get<uint64_t>(position);
+        };
+
+        const uint64_t start_frame = m_Configuration.start_position.has_value()
+            ? to_frame_number(*m_Configuration.start_position) : 0;
+
+        std::optional<uint64_t> end_frame;
+        if(m_Configuration.end_position.has_value())
+            end_frame = to_frame_number(*m_Configuration.end_position);
+
+        if(position_error.has_value())
+            return position_error;
+
+        if(end_frame.has_value() && *end_frame <= start_frame)
+        {
+            return cv::format(
+                "The end frame %llu must come after the start frame %llu",
+                static_cast<unsigned long long>(*end_frame),
+                static_cast<unsigned long long>(start_frame)
+            );
+        }
+
+        // Stabilizers delay their output while building up context. So we prime them with
+        // the frames before the start, and read past the end to flush out the last frames.
+        uint64_t context_frames = 0;
+        for(const auto& filter : m_Configuration.filter_chain)
+        {
+            if(const auto stabilizer = std::dynamic_pointer_cast<lvk::StabilizationFilter>(filter))
+                context_frames += stabilizer->frame_delay();
+        }
+
+        const uint64_t lead_frames = std::min(context_frames, start_frame);
+        m_ReadStart = start_frame - lead_frames;
+        m_SkipOutputs = lead_frames;
+
+        if(end_frame.has_value())
+        {
+            m_OutputLimit = *end_frame - start_frame;
+            m_ReadLimit = lead_frames + *m_OutputLimit + context_frames;
+        }
+
+        const uint64_t frame_count = m_ReadCount;
+        m_ReadCount = m_ReadLimit.value_or(frame_count > m_ReadStart ? frame_count - m_ReadStart : 0);
+
+        if(m_ReadStart > 0 && !m_InputStream->seek(m_ReadStart))
+            return cv::format("Failed to seek to frame %llu of the input", static_cast<unsigned long long>(m_ReadStart));
+
         return std::nullopt;
     }
 
@@ -97,43 +217,53 @@ namespace clt
         if(!m_Configuration.output_target.has_value())
             return "Could not create output stream, no target was specified";
 
-        try {
-            std::vector<int> properties = {
-                cv::VideoWriterProperties::VIDEOWRITER_PROP_HW_ACCELERATION, 1,
-                cv::VideoWriterProperties::VIDEOWRITER_PROP_HW_ACCELERATION_USE_OPENCL, 1
-            };
-
-            m_OutputStream = cv::VideoWriter(
-                m_Configuration.output_target->string(),
-                cv::CAP_FFMPEG,
-                m_Configuration.output_codec.value_or(
-                    static_cast<int>(m_InputStream.get(cv::CAP_PROP_FOURCC))
-                ),
-                m_Configuration.output_framerate.value_or(
-                    std::max(m_InputStream.get(cv::CAP_PROP_FPS), 1.0)
-                ),
-                frame_size,
-                properties
+        const int codec = m_Configuration.output_codec.value_or(m_InputStream->codec());
+        const double framerate = m_Configuration.output_framerate.value_or(
+            std::max(m_InputStream->framerate(), 1.0)
+        );
+
+        std::optional<std::string> output_error;
+        std::unique_ptr<VideoSink> output_stream;
+        if(is_piped_output())
+        {
+            // Match the layout of the input pipe, so frames pass through unchanged.
+            auto stream = std::make_unique<PipeSink>();
+            output_error = stream->open(
+                !m_Configuration.raw_layout.has_value(),
+                m_Configuration.raw_layout.value_or(m_PipeLayout),
+                framerate,
+                frame_size
             );
+            output_stream = std::move(stream);
         }
-        catch(std::exception& e)
+        else if(m_Configuration.use_libav)
         {
-            return cv::format(
-                "Failed to create output stream with error \'%s\'",
-                e.what()
-            );
+#ifdef LVK_HAS_LIBAV
+            auto stream = std::make_unique<LibavSink>();
+            output_error = stream->open(*m_Configuration.output_target, codec, framerate, frame_size);
+            output_stream = std::move(stream);
+#else
+            output_error = "The libav backend is not available in this build";
+#endif
+        }
+        else
+        {
+            auto stream = std::make_unique<OpenCVSink>();
+            output_error = stream->open(*m_Configuration.output_target, codec, framerate, frame_size);
+            output_stream = std::move(stream);
         }
 
-        // If stream is still not opened, then creation failed
-        if(!m_OutputStream.isOpened())
+        // Encode on a separate writer thread so the encoder doesn't stall the filters.
+        if(!output_error.has_value())
         {
-            return cv::format(
-                "Failed to create an output stream at \'%s\'",
-                m_Configuration.output_target->string().c_str()
+            m_OutputStream = std::make_unique<AsyncSink>(
+                std::move(output_stream),
+                m_Configuration.encoder_buffer_frames,
+                FILTER_TIMING_SAMPLES
             );
         }
 
-        return std::nullopt;
+        return output_error;
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -143,6 +273,25 @@ namespace clt
         m_Terminate = true;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<double> VideoProcessor::progress() const
+    {
+        const uint64_t read_count = m_ReadCount;
+        if(read_count == 0)
+            return std::nullopt;
+
+        return std::min(static_cast<double>(m_FramesRead) / static_cast<double>(read_count), 1.0);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    uint64_t VideoProcessor::frames_processed() const
+    {
+        const uint64_t frames_output = m_FramesOutput;
+        return frames_output > m_SkipOutputs ? frames_output - m_SkipOutputs : 0;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     std::optional<std::string> VideoProcessor::run()
@@ -153,44 +302,86 @@ namespace clt
         if(runtime_error.has_value())
             return runtime_error;
 
-        // Create output window, making sure its resizable
+        if(m_Configuration.tune_opencl)
+        {
+            m_ConsoleLogger.raw() << "Tuning OpenCL work group sizes..." << std::endl;
+            if(!lvk::ocl::tune_work_groups(m_InputStream->resolution()))
+                m_ConsoleLogger.raw() << "Failed to tune OpenCL work group sizes" << std::endl;
+        }
+
+        if(m_Configuration.bench_frames.has_value())
+            return run_benchmark();
+
+        // Create the output window, which renders on its own thread.
         if(m_Configuration.render_output)
-            cv::namedWindow(RENDER_WINDOW_NAME, cv::WINDOW_NORMAL | cv::WINDOW_KEEPRATIO);
+            m_Preview = std::make_unique<PreviewWindow>(RENDER_WINDOW_NAME);
+
+        if(m_Configuration.trace_target.has_value())
+            lvk::Trace::enable();
 
         m_FrameTimer.start();
         m_ProcessTimer.start();
         lvk::Time last_update_time;
 
+        // Real-time streams keep only the newest couple of frames buffered, dropping the
+        // rest, so that a slow filter chain never falls behind the input capture.
+        lvk::StreamPolicy stream_policy;
+        if(is_real_time())
+        {
+            stream_policy.real_time = true;
+            stream_policy.buffer_frames = REAL_TIME_BUFFER_FRAMES;
+            stream_policy.latency_budget = m_Configuration.latency_budget.value_or(stream_policy.latency_budget);
+        }
+
         // Run the processor filter
         m_Terminate = false;
         m_Processor.stream(
-            m_InputStream,
+            [this](lvk::Frame& frame) {
+                // Stop reading once past the end of the trimmed range.
+                if(m_ReadLimit.has_value() && m_FramesRead >= *m_ReadLimit)
+                    return false;
+
+                if(!m_InputStream->read(frame))
+                    return false;
+
+                m_FramesRead++;
+                return true;
+            },
             [&, this](lvk::Frame& frame) {
+                // Discard the outputs of the frames used to prime the filters.
+                const uint64_t output_index = m_FramesOutput++;
+                if(output_index < m_SkipOutputs)
+                    return m_Terminate;
+
                 // Write output
                 if(m_Configuration.output_target.has_value())
                 {
                     // Lazily initialize the output stream on first output frame
-                    if(!m_OutputStream.isOpened())
+                    if(m_OutputStream == nullptr)
                     {
                         runtime_error = initialize_output_stream(frame.size());
                         if(runtime_error.has_value())
                             return true;
                     }
 
-                    m_OutputStream.write(frame);
+                    if(!m_OutputStream->write(frame))
+                    {
+                        runtime_error = "Failed to write to the output stream";
+                        return true;
+                    }
                 }
 
                 // Display output
+                // NOTE: the preview renders on its own thread and never waits on us.
                 if(m_Configuration.render_output)
                 {
-                    cv::imshow(RENDER_WINDOW_NAME, frame);
-
-                    // Close display if escape is pressed, also note that
-                    // the poll event is required to update the window.
-                    if(const auto key = cv::pollKey(); key == 27)
+                    if(m_Preview->is_open())
+                        m_Preview->show(frame);
+                    else
                     {
+                        // The display was closed by pressing escape.
                         m_Configuration.render_output = false;
-                        cv::destroyAllWindows();
+                        m_Preview.reset();
 
                         // If the input is a device capture or there is no output path, then
                         // we consider the display to the output. So closing the window should
@@ -211,6 +402,7 @@ namespace clt
                 else m_FrameTimer.tick();
 
                 // Run all update procedures (logging etc.)
+                log_quality_changes();
                 const auto elapsed_time = m_ProcessTimer.elapsed();
                 if(last_update_time.is_zero() || elapsed_time > last_update_time + m_Configuration.update_period)
                 {
@@ -218,55 +410,308 @@ namespace clt
                     write_to_loggers();
                 }
 
-                return m_Terminate;
+                // End the processing once the trimmed range has been output.
+                const bool range_finished = m_OutputLimit.has_value()
+                    && output_index + 1 >= m_SkipOutputs + *m_OutputLimit;
+
+                return m_Terminate || range_finished;
             },
+            stream_policy,
             m_Configuration.print_timings || m_DataLogger.has_value()
         );
 
+        // Close the display, if it is still open.
+        m_Preview.reset();
+
         // Run loggers one last time to ensure we have the latest statistics displayed.
         write_to_loggers();
 
+        // Flush any frames still buffered by the output.
+        if(m_OutputStream != nullptr)
+        {
+            m_OutputStream->close();
+            if(m_OutputStream->has_failed() && !runtime_error.has_value())
+                runtime_error = "Failed to write to the output stream";
+        }
+
+        if(m_Configuration.trace_target.has_value())
+        {
+            lvk::Trace::enable(false);
+
+            std::ofstream trace_stream(*m_Configuration.trace_target);
+            if(!trace_stream.good())
+            {
+                return cv::format(
+                    "Failed to write the trace to '%s'",
+                    m_Configuration.trace_target->string().c_str()
+                );
+            }
+            lvk::Trace::write(trace_stream);
+        }
+
         return runtime_error;
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    std::optional<std::string> VideoProcessor::run_benchmark()
+    {
+        LVK_ASSERT(m_Configuration.bench_frames.has_value());
+
+        // Predecode all the frames, so that decoding is not part of the benchmark.
+        std::vector<lvk::VideoFrame> frames;
+        frames.reserve(*m_Configuration.bench_frames);
+
+        lvk::VideoFrame read_frame;
+        while(frames.size() < *m_Configuration.bench_frames && m_InputStream->read(read_frame))
+            frames.push_back(std::move(read_frame));
+
+        if(frames.empty())
+            return "Failed to read any frames to benchmark";
+
+        const auto& filters = m_Processor.filters();
+        std::vector<lvk::Stopwatch> filter_timers(filters.size());
+        std::vector<uint64_t> filter_allocations(filters.size(), 0);
+        std::vector<lvk::Time> filter_totals(filters.size());
+        lvk::Stopwatch chain_timer;
+        lvk::Time chain_total;
+
+        // NOTE: only device allocations are counted, as the filters work on UMats.
+        auto& allocator_statistics = cv::ocl::getOpenCLAllocatorStatistics();
+
+        lvk::VideoFrame input_frame, output_frame;
+        const auto run_pass = [&](const bool measure) {
+            for(const auto& frame : frames)
+            {
+                // NOTE: filters take ownership of their input, so the frame must be copied.
+                frame.copyTo(input_frame);
+
+                // NOTE: the device is synced around each filter so that its time covers the execution of
+                // its OpenCL work, not just its enqueuing. The input copy is synced first, so is not counted.
+                chain_timer.sync_gpu().start();
+                for(size_t i = 0; i < filters.size() && !input_frame.empty(); i++)
+                {
+                    const auto allocations = allocator_statistics.getNumberOfAllocations();
+
+                    filter_timers[i].start();
+                    filters[i]->apply(std::move(input_frame), output_frame, false);
+                    const auto filter_time = filter_timers[i].sync_gpu().stop();
+
+                    if(measure)
+                    {
+                        filter_totals[i] += filter_time;
+                        filter_allocations[i] += allocator_statistics.getNumberOfAllocations() - allocations;
+                    }
+                    input_frame = std::move(output_frame);
+                }
+                const auto chain_time = chain_timer.sync_gpu().stop();
+
+                if(measure) chain_total += chain_time;
+            }
+        };
+
+        // Run a single warm-up pass to get all the allocations and kernel compilations out of the way.
+        m_ConsoleLogger.raw() << "Benchmarking " << frames.size() << " frames..." << std::endl;
+        run_pass(false);
+        cv::ocl::finish();
+
+        chain_timer.reset_history();
+        for(auto& timer : filter_timers)
+            timer.reset_history();
+
+        // Run the benchmark, making sure to wait for the device at the end.
+        uint64_t passes = 0;
+        lvk::Stopwatch bench_timer;
+        bench_timer.start();
+        do
+        {
+            run_pass(true);
+            passes++;
+        }
+        while(m_Configuration.bench_passes.has_value()
+              ? passes < *m_Configuration.bench_passes
+              : bench_timer.elapsed() < m_Configuration.bench_duration);
+        cv::ocl::finish();
+        const auto bench_time = bench_timer.stop();
+
+        const uint64_t processed_frames = passes * frames.size();
+        const uint64_t total_allocations = std::accumulate(filter_allocations.begin(), filter_allocations.end(), 0ull);
+
+        // Write out the JSON report
+        std::ostream& report = std::cout;
+        report << std::fixed << std::setprecision(3);
+        report << "{\n";
+
+        const auto& source = m_Configuration.input_source;
+        const auto input_name = std::holds_alternative<std::filesystem::path>(source)
+            ? std::get<std::filesystem::path>(source).generic_string()
+            : "device";
+        report << "  \"input\": \"" << input_name << "\",\n"
+               << "  \"resolution\": [" << frames.front().cols << ", " << frames.front().rows << "],\n"
+               << "  \"frames\": " << frames.size() << ",\n"
+               << "  \"passes\": " << passes << ",\n"
+               << "  \"duration_s\": " << bench_time.seconds() << ",\n";
+
+        // NOTE: the end-to-end FPS includes waiting for the device to finish.
+        report << "  \"pipeline\": {\"fps\": " << static_cast<double>(processed_frames) / bench_time.seconds() << ", ";
+        write_bench_timings(report, chain_timer, chain_total, total_allocations);
+        report << "},\n";
+
+        report << "  \"filters\": [\n";
+        for(size_t i = 0; i < filters.size(); i++)
+        {
+            const auto filter_count = filter_timers[i].histogram().count();
+            const double filter_fps = filter_totals[i].is_zero() ? 0.0
+                : static_cast<double>(filter_count) / filter_totals[i].seconds();
+
+            report << "    {\"name\": \"" << filters[i]->alias() << "\", \"fps\": " << filter_fps << ", ";
+            write_bench_timings(report, filter_timers[i], filter_totals[i], filter_allocations[i]);
+            report << ((i + 1 < filters.size()) ? "},\n" : "}\n");
+        }
+        report << "  ]\n}" << std::endl;
+
+        return std::nullopt;
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoProcessor::write_bench_timings(
+        std::ostream& stream,
+        const lvk::Stopwatch& timer,
+        const lvk::Time& total_time,
+        const uint64_t allocations
+    )
+    {
+        const auto& histogram = timer.histogram();
+        const auto samples = std::max<uint64_t>(histogram.count(), 1);
+
+        stream << "\"mean_ms\": " << (total_time / static_cast<double>(samples)).milliseconds()
+               << ", \"p50_ms\": " << histogram.percentile(50.0).milliseconds()
+               << ", \"p90_ms\": " << histogram.percentile(90.0).milliseconds()
+               << ", \"p99_ms\": " << histogram.percentile(99.0).milliseconds()
+               << ", \"p99.9_ms\": " << histogram.percentile(99.9).milliseconds()
+               << ", \"max_ms\": " << histogram.max().milliseconds()
+               << ", \"allocations\": " << allocations
+               << ", \"allocations_per_frame\": " << static_cast<double>(allocations) / static_cast<double>(samples);
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoProcessor::is_real_time() const
+    {
+        return m_DeviceCapture || m_Configuration.latency_budget.has_value();
+    }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+    bool VideoProcessor::is_piped_output() const
+    {
+        return m_Configuration.output_target.has_value() && is_standard_stream(*m_Configuration.output_target);
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoProcessor::write_to_loggers()
     {
-        m_ConsoleLogger.clear();
+        if(m_Configuration.print_progress)
+        {
+            m_ConsoleLogger.clear();
 
-        print_progress();
-        if(m_Configuration.print_timings)
-            print_filter_timings();
+            print_progress();
+            if(m_Configuration.print_timings)
+            {
+                print_filter_timings();
+                print_encoder_statistics();
+            }
+        }
 
         if(m_DataLogger.has_value())
             log_timing_data();
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoProcessor::log_quality_changes()
+    {
+        // NOTE: stabilizers hold each quality level for many frames, so
+        // polling them on every output is enough to catch every change.
+        m_QualityLevels.resize(m_Configuration.filter_chain.size(), 0);
+        for(size_t i = 0; i < m_Configuration.filter_chain.size(); i++)
+        {
+            const auto stabilizer = std::dynamic_pointer_cast<lvk::StabilizationFilter>(
+                m_Configuration.filter_chain[i]
+            );
+            if(stabilizer == nullptr)
+                continue;
+
+            const size_t quality_level = stabilizer->quality_level();
+            if(quality_level == m_QualityLevels[i])
+                continue;
+
+            const auto message = cv::format(
+                "%s quality level changed from %zu to %zu at frame %llu (%.2fms)",
+                stabilizer->alias().c_str(),
+                m_QualityLevels[i],
+                quality_level,
+                static_cast<unsigned long long>(m_FramesOutput.load()),
+                stabilizer->timings().average().milliseconds()
+            );
+
+            // Clear the live display so the change is printed above it, where it stays. Otherwise,
+            // such as in batch jobs, the change is written to stderr along with the input it is for.
+            if(m_Configuration.print_progress)
+            {
+                m_ConsoleLogger.clear();
+                m_ConsoleLogger.raw() << message << std::endl;
+            }
+            else
+            {
+                const auto& source = m_Configuration.input_source;
+                const auto input_name = std::holds_alternative<std::filesystem::path>(source)
+                    ? std::get<std::filesystem::path>(source).filename().string()
+                    : std::string("device");
+
+                std::cerr << "[" << input_name << "] " << message << std::endl;
+            }
+            m_QualityLevels[i] = quality_level;
+        }
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoProcessor::print_progress()
     {
         // NOTE: The frame count is not valid for device capture streams
-        double frame_count = m_InputStream.get(cv::CAP_PROP_FRAME_COUNT);
-        double frame_number = m_InputStream.get(cv::CAP_PROP_POS_FRAMES);
+        const auto frame_count = static_cast<double>(m_InputStream->frame_count());
+        const auto frame_number = static_cast<double>(m_InputStream->frame_number());
+
+        // Trimmed inputs only report progress over the frames being read.
+        const auto read_start = static_cast<double>(m_ReadStart);
+        const auto read_count = m_ReadLimit.has_value()
+            ? static_cast<double>(*m_ReadLimit) : frame_count - read_start;
+        const auto read_number = std::max(frame_number - read_start, 0.0);
+
+        // NOTE: the length of piped input is never known.
+        const bool known_length = !m_DeviceCapture && read_count > 0;
 
         // Input Stream Info
         m_ConsoleLogger << "Processing target: ";
         if(!m_DeviceCapture)
         {
-            m_ConsoleLogger << std::get<std::filesystem::path>(m_Configuration.input_source).string()
-                            << "  " << make_progress_bar(40, frame_number / frame_count)
-                            << ConsoleLogger::Next;
+            const auto& path = std::get<std::filesystem::path>(m_Configuration.input_source);
+            m_ConsoleLogger << (is_standard_stream(path) ? "stdin" : path.string());
+            if(known_length)
+                m_ConsoleLogger << "  " << make_progress_bar(40, std::min(read_number / read_count, 1.0));
+            m_ConsoleLogger << ConsoleLogger::Next;
         }
         else m_ConsoleLogger << "Device Capture" << ConsoleLogger::Next;
 
         // Print Elapsed time
         m_ConsoleLogger << "   Elapsed: " << m_ProcessTimer.elapsed().hms();
-        if(!m_DeviceCapture)
+        if(known_length)
         {
             lvk::Time est_remaining_time = lvk::Time::Seconds(
-                std::ceil((frame_count - frame_number) / m_FrameTimer.average().frequency())
+                std::ceil(std::max(read_count - read_number, 0.0) / m_FrameTimer.average().frequency())
             );
             m_ConsoleLogger << " (est. " << est_remaining_time.hms() << " remaining)";
         }
@@ -284,6 +729,20 @@ namespace clt
         m_ConsoleLogger << "   FPS: "
                         << std::fixed << std::setprecision(0) << m_FrameTimer.average().frequency()
                         << ConsoleLogger::Next;
+
+        // Print the frames dropped to keep up with real-time input.
+        if(is_real_time())
+        {
+            const auto& statistics = m_Processor.stream_statistics();
+            m_ConsoleLogger << "   Dropped: " << statistics.dropped_frames.load()
+                            << " (" << statistics.stale_frames.load() << " stale)"
+                            << ConsoleLogger::Next;
+
+            m_ConsoleLogger << "   Latency: " << std::setprecision(1)
+                            << "p50 " << statistics.latency.percentile(50.0).milliseconds() << "ms"
+                            << "   p99 " << statistics.latency.percentile(99.0).milliseconds() << "ms"
+                            << ConsoleLogger::Next;
+        }
     }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -302,11 +761,71 @@ namespace clt
                             << filter->alias()
                             << "\t" << average_timing.milliseconds() << "ms"
                             << " +/- " << filter->timings().deviation().milliseconds() << "ms"
-                            << "   (" << static_cast<uint64_t>(average_timing.frequency()) << "FPS)"
+                            << "   (" << static_cast<uint64_t>(average_timing.frequency()) << "FPS)";
+
+            // Device timings are only available when the filter runs on OpenCL.
+            const auto& device_timings = filter->device_timings();
+            if(!device_timings.history().is_empty())
+            {
+                m_ConsoleLogger << "   [GPU " << device_timings.average().milliseconds() << "ms"
+                                << " +/- " << device_timings.deviation().milliseconds() << "ms]";
+            }
+
+            m_ConsoleLogger << ConsoleLogger::Next;
+
+            // Print the tail latencies over the whole run.
+            const auto& histogram = filter->timings().histogram();
+            m_ConsoleLogger << "    "
+                            << "\tp50 " << histogram.percentile(50.0).milliseconds() << "ms"
+                            << "   p90 " << histogram.percentile(90.0).milliseconds() << "ms"
+                            << "   p99 " << histogram.percentile(99.0).milliseconds() << "ms"
+                            << "   p99.9 " << histogram.percentile(99.9).milliseconds() << "ms"
+                            << "   max " << histogram.max().milliseconds() << "ms"
+                            << ConsoleLogger::Next;
+
+            // Print the host memory held by the filter, and its peak over the run.
+            const auto memory = filter->memory_usage();
+            m_ConsoleLogger << "    "
+                            << "\tMemory " << static_cast<double>(memory.current_bytes) / BYTES_PER_MB << "MB"
+                            << "   Peak " << static_cast<double>(memory.peak_bytes) / BYTES_PER_MB << "MB"
+                            << ConsoleLogger::Next;
+        }
+
+        // Device memory is allocated by OpenCV's OpenCL allocator, so is only known in total.
+        if(cv::ocl::useOpenCL())
+        {
+            const auto device_memory = lvk::MemoryTracker::device_usage();
+            m_ConsoleLogger << "    "
+                            << "\tDevice Memory " << static_cast<double>(device_memory.current_bytes) / BYTES_PER_MB << "MB"
+                            << "   Peak " << static_cast<double>(device_memory.peak_bytes) / BYTES_PER_MB << "MB"
                             << ConsoleLogger::Next;
         }
     }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+    void VideoProcessor::print_encoder_statistics()
+    {
+        if(m_OutputStream == nullptr)
+            return;
+
+        const auto statistics = m_OutputStream->statistics();
+
+        m_ConsoleLogger << ConsoleLogger::Next << "Encoder: " << ConsoleLogger::Next;
+        m_ConsoleLogger << "    "
+                        << "\t" << statistics.encode_time.milliseconds() << "ms"
+                        << " +/- " << statistics.encode_deviation.milliseconds() << "ms"
+                        << "   (" << statistics.frames_written << " frames)"
+                        << ConsoleLogger::Next;
+
+        // If the queue is often full or the producer is blocked, the encoder is the bottleneck.
+        m_ConsoleLogger << "    "
+                        << "\tQueue " << statistics.queue_depth << "/" << statistics.queue_capacity
+                        << "   Peak " << statistics.queue_peak
+                        << "   Blocked " << statistics.blocked_time.seconds() << "s"
+                        << ConsoleLogger::Next;
+    }
+
 //---------------------------------------------------------------------------------------------------------------------
 
     void VideoProcessor::log_timing_data()
@@ -324,6 +843,11 @@ namespace clt
             // 3. All filter frametimes
             // 4. Processor deviation
             // 5. All filter deviations
+            // 6. All filter p50, p90, p99, p99.9 and max frametimes
+            // 7. Encoder frametime, queue depth and blocked time
+            // 8. Dropped and stale frames, and latency p99 of real-time streams
+            // 9. All filter current and peak memory, then total device memory
+            // 10. All stabilizer quality levels
 
             logger << "Output Frame";
 
@@ -336,6 +860,38 @@ namespace clt
             for(auto& filter : m_Processor.filters())
                 logger << (filter->alias() + " Deviation (ms)");
 
+            // Then log all the frametime percentiles
+            for(auto& filter : m_Processor.filters())
+            {
+                logger << (filter->alias() + " p50 (ms)");
+                logger << (filter->alias() + " p90 (ms)");
+                logger << (filter->alias() + " p99 (ms)");
+                logger << (filter->alias() + " p99.9 (ms)");
+                logger << (filter->alias() + " Max (ms)");
+            }
+
+            logger << "Encoder Frametime (ms)";
+            logger << "Encoder Queue Depth";
+            logger << "Encoder Blocked (ms)";
+
+            logger << "Dropped Frames";
+            logger << "Stale Frames";
+            logger << "Latency p99 (ms)";
+
+            for(auto& filter : m_Processor.filters())
+            {
+                logger << (filter->alias() + " Memory (MB)");
+                logger << (filter->alias() + " Peak Memory (MB)");
+            }
+            logger << "Device Memory (MB)";
+            logger << "Device Peak Memory (MB)";
+
+            for(auto& filter : m_Processor.filters())
+            {
+                if(std::dynamic_pointer_cast<lvk::StabilizationFilter>(filter) != nullptr)
+                    logger << (filter->alias() + " Quality Level");
+            }
+
             logger.next();
         }
 
@@ -352,6 +908,47 @@ namespace clt
         for(auto& filter : m_Processor.filters())
             logger << filter->timings().deviation().milliseconds();
 
+        // write all frametime percentiles
+        for(auto& filter : m_Processor.filters())
+        {
+            const auto& histogram = filter->timings().histogram();
+            logger << histogram.percentile(50.0).milliseconds();
+            logger << histogram.percentile(90.0).milliseconds();
+            logger << histogram.percentile(99.0).milliseconds();
+            logger << histogram.percentile(99.9).milliseconds();
+            logger << histogram.max().milliseconds();
+        }
+
+        // write encoder statistics
+        const auto statistics = m_OutputStream != nullptr ? m_OutputStream->statistics() : SinkStatistics{};
+        logger << statistics.encode_time.milliseconds();
+        logger << statistics.queue_depth;
+        logger << statistics.blocked_time.milliseconds();
+
+        // write real-time stream statistics
+        const auto& stream_statistics = m_Processor.stream_statistics();
+        logger << stream_statistics.dropped_frames.load();
+        logger << stream_statistics.stale_frames.load();
+        logger << stream_statistics.latency.percentile(99.0).milliseconds();
+
+        // write all filter memory usage
+        for(auto& filter : m_Processor.filters())
+        {
+            const auto memory = filter->memory_usage();
+            logger << static_cast<double>(memory.current_bytes) / BYTES_PER_MB;
+            logger << static_cast<double>(memory.peak_bytes) / BYTES_PER_MB;
+        }
+        const auto device_memory = lvk::MemoryTracker::device_usage();
+        logger << static_cast<double>(device_memory.current_bytes) / BYTES_PER_MB;
+        logger << static_cast<double>(device_memory.peak_bytes) / BYTES_PER_MB;
+
+        // write all stabilizer quality levels
+        for(auto& filter : m_Processor.filters())
+        {
+            if(const auto stabilizer = std::dynamic_pointer_cast<lvk::StabilizationFilter>(filter); stabilizer != nullptr)
+                logger << stabilizer->quality_level();
+        }
+
         logger.next();
     }
 
@@ -19,9 +19,13 @@
 
 #include <LiveVisionKit.hpp>
 #include <fstream>
+#include <atomic>
 
 #include "VideoIOConfiguration.hpp"
 #include "ConsoleLogger.hpp"
+#include "VideoSource.hpp"
+#include "AsyncSink.hpp"
+#include "PreviewWindow.hpp"
 
 namespace clt
 {
@@ -36,35 +40,69 @@ namespace clt
 
         void stop();
 
+        // NOTE: both are safe to call from other threads while running.
+        std::optional<double> progress() const;
+
+        uint64_t frames_processed() const;
+
     private:
 
         std::optional<std::string> initialize_configuration();
 
         std::optional<std::string> initialize_output_stream(const cv::Size frame_size);
 
+        std::optional<std::string> initialize_trimming();
+
+        std::optional<std::string> run_benchmark();
+
+        bool is_real_time() const;
+
+        bool is_piped_output() const;
+
         void write_to_loggers();
 
+        void log_quality_changes();
+
         void print_progress();
 
         void print_filter_timings();
 
+        void print_encoder_statistics();
+
         void log_timing_data();
 
         static std::string make_progress_bar(const uint32_t length, const double progress);
 
+        static void write_bench_timings(
+            std::ostream& stream,
+            const lvk::Stopwatch& timer,
+            const lvk::Time& total_time,
+            const uint64_t allocations
+        );
+
     private:
         VideoIOConfiguration m_Configuration;
         bool m_DeviceCapture = false;
+        PixelLayout m_PipeLayout = PixelLayout::YUV420P;
 
         std::ofstream m_DataLogStream;
         std::optional<lvk::CSVLogger> m_DataLogger;
         ConsoleLogger m_ConsoleLogger;
 
-        cv::VideoCapture m_InputStream;
-        cv::VideoWriter m_OutputStream;
+        std::unique_ptr<VideoSource> m_InputStream;
+        std::unique_ptr<AsyncSink> m_OutputStream;
+        std::unique_ptr<PreviewWindow> m_Preview;
         lvk::CompositeFilter m_Processor;
 
-        bool m_Terminate = false;
+        // NOTE: the frames before the start are read to prime the filters, but never output.
+        uint64_t m_ReadStart = 0, m_SkipOutputs = 0;
+        std::optional<uint64_t> m_ReadLimit, m_OutputLimit;
+        std::atomic<uint64_t> m_FramesRead = 0, m_FramesOutput = 0, m_ReadCount = 0;
+
+        // NOTE: the last logged quality level of each filter, only stabilizers are governed.
+        std::vector<size_t> m_QualityLevels;
+
+        std::atomic<bool> m_Terminate = false;
         lvk::TickTimer m_FrameTimer;
         lvk::Stopwatch m_ProcessTimer;
     };
@@ -0,0 +1,55 @@
+//     *************************** LiveVisionKit ****************************
+//     Copyright (C) 2022  Sebastian Di Marco (crowsinc.dev@gmail.com)
+//
+//     This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//     **********************************************************************
+
+#pragma once
+
+#include <LiveVisionKit.hpp>
+
+namespace clt
+{
+
+    class VideoSource
+    {
+    public:
+
+        virtual ~VideoSource() = default;
+
+        // NOTE: must set the format and timestamp of the frame.
+        virtual bool read(lvk::VideoFrame& frame) = 0;
+
+        // Seeks so that the next frame read is the given frame number,
+        // by decoding from the nearest preceding keyframe if necessary.
+        virtual bool seek(const uint64_t frame_number) = 0;
+
+        virtual bool is_open() const = 0;
+
+
+        virtual cv::Size resolution() const = 0;
+
+        virtual double framerate() const = 0;
+
+        // NOTE: the fourcc of the source codec, or zero if unknown.
+        virtual int codec() const = 0;
+
+
+        // NOTE: both are zero if unknown, such as for device captures.
+        virtual uint64_t frame_count() const = 0;
+
+        virtual uint64_t frame_number() const = 0;
+    };
+
+}